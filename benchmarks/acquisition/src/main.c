@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2025 HX711 Acquisition Benchmark by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "hx711_driver.h"
+#ifdef CONFIG_TIMING_FUNCTIONS
+#include <zephyr/timing/timing.h>
+#endif
+#ifdef CONFIG_HX711_ASYNC
+#include <zephyr/rtio/rtio.h>
+#endif
+
+/* Output is one CSV record per line, prefixed so it can be grepped out of
+ * the console log:
+ *
+ * BENCH,<name>,<transport>,<mode>,<n>,<min>,<mean>,<p99>,<max>,<clock>,<hz>
+ *   latency distribution in <clock> cycles, <hz> cycles per second
+ * RATE,<name>,<transport>,<mode>,<channel>,<samples>,<errors>,<ms>,<milli_sps>
+ *   sustained samples per second per channel, times 1000
+ */
+
+#define BENCH_SAMPLES 256
+#define BENCH_RUN_MS  2000
+#define BENCH_WAIT    K_MSEC(200)
+
+/* 24 data pulses and 3 gain pulses per conversion at gain 64 */
+#define BENCH_PULSES 27
+
+static const struct device *const bench_devs[] = { HX711_DT_DEVICES };
+
+BUILD_ASSERT(ARRAY_SIZE(bench_devs) > 0, "No enabled avia,hx711 nodes in devicetree");
+
+static uint32_t bench_cycles[BENCH_SAMPLES];
+static uint32_t bench_wait_cycles[BENCH_SAMPLES];
+static uint32_t bench_bit_cycles[BENCH_SAMPLES];
+#ifdef CONFIG_HX711_TRIGGER
+static uint32_t bench_latency[BENCH_SAMPLES];
+#endif
+
+static struct hx711_array bench_array;
+
+#ifdef CONFIG_HX711_TRIGGER
+#define BENCH_MODE "trigger"
+#else
+#define BENCH_MODE "poll"
+#endif
+
+/* Fine grained timestamps where the SoC has them, kernel cycles otherwise */
+#ifdef CONFIG_TIMING_FUNCTIONS
+#define BENCH_CLOCK "timing"
+typedef timing_t bench_stamp_t;
+
+static inline bench_stamp_t bench_stamp(void)
+{
+	return timing_counter_get();
+}
+
+static inline uint32_t bench_elapsed(bench_stamp_t start, bench_stamp_t end)
+{
+	return (uint32_t)timing_cycles_get(&start, &end);
+}
+
+static uint64_t bench_hz(void)
+{
+	return timing_freq_get();
+}
+#else
+#define BENCH_CLOCK "kcycle"
+typedef uint32_t bench_stamp_t;
+
+static inline bench_stamp_t bench_stamp(void)
+{
+	return k_cycle_get_32();
+}
+
+static inline uint32_t bench_elapsed(bench_stamp_t start, bench_stamp_t end)
+{
+	return end - start;
+}
+
+static uint64_t bench_hz(void)
+{
+	return sys_clock_hw_cycles_per_sec();
+}
+#endif
+
+static const char *bench_transport(const struct device *dev)
+{
+#ifdef CONFIG_HX711_SPI
+	const struct hx711_config *cfg = dev->config;
+
+	if (cfg->use_spi) {
+		return "spi";
+	}
+#else
+	ARG_UNUSED(dev);
+#endif
+	return "gpio";
+}
+
+static int bench_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Sorts values in place */
+static void bench_report(const char *name, const char *transport, uint32_t *values, size_t n,
+			 const char *clock, uint64_t hz)
+{
+	uint64_t sum = 0;
+
+	if (n == 0) {
+		printk("BENCH,%s,%s,%s,0,,,,,%s,%llu\n", name, transport, BENCH_MODE, clock,
+		       (unsigned long long)hz);
+		return;
+	}
+
+	qsort(values, n, sizeof(values[0]), bench_cmp);
+	for (size_t i = 0; i < n; i++) {
+		sum += values[i];
+	}
+
+	printk("BENCH,%s,%s,%s,%u,%u,%u,%u,%u,%s,%llu\n", name, transport, BENCH_MODE,
+	       (unsigned int)n, values[0], (uint32_t)(sum / n), values[(n * 99) / 100],
+	       values[n - 1], clock, (unsigned long long)hz);
+}
+
+static void bench_report_rate(const char *name, const char *transport, int channel,
+			      uint32_t samples, uint32_t errors, uint32_t ms)
+{
+	printk("RATE,%s,%s,%s,%d,%u,%u,%u,%u\n", name, transport, BENCH_MODE, channel, samples,
+	       errors, ms, (uint32_t)(((uint64_t)samples * 1000000) / MAX(ms, 1)));
+}
+
+/* hx711_wait_for_data(), hx711_read_raw() and the data-ready latency */
+static void bench_single(const struct device *dev)
+{
+	const char *transport = bench_transport(dev);
+	size_t n = 0;
+	int32_t value;
+
+	while (n < BENCH_SAMPLES) {
+		bench_stamp_t start = bench_stamp();
+
+		if (hx711_wait_for_data(dev, BENCH_WAIT) < 0) {
+			printk("%s: no data\n", dev->name);
+			return;
+		}
+
+		bench_stamp_t ready = bench_stamp();
+#ifdef CONFIG_HX711_TRIGGER
+		uint32_t latency = k_cycle_get_32() - ((struct hx711_data *)dev->data)->drdy_cycles;
+#endif
+		int ret = hx711_read_raw(dev, &value);
+		bench_stamp_t end = bench_stamp();
+
+		if (ret < 0) {
+			continue;
+		}
+
+		bench_wait_cycles[n] = bench_elapsed(start, ready);
+		bench_cycles[n] = bench_elapsed(ready, end);
+		bench_bit_cycles[n] = bench_cycles[n] / BENCH_PULSES;
+#ifdef CONFIG_HX711_TRIGGER
+		bench_latency[n] = latency;
+#endif
+		n++;
+	}
+
+	printk("# %s\n", dev->name);
+	bench_report("wait_for_data", transport, bench_wait_cycles, n, BENCH_CLOCK, bench_hz());
+	bench_report("read_raw", transport, bench_cycles, n, BENCH_CLOCK, bench_hz());
+	bench_report("bit", transport, bench_bit_cycles, n, BENCH_CLOCK, bench_hz());
+#ifdef CONFIG_HX711_TRIGGER
+	/* Against the interrupt timestamp, as the driver's stats measure it */
+	bench_report("drdy_latency", transport, bench_latency, n, "kcycle",
+		     sys_clock_hw_cycles_per_sec());
+#endif
+}
+
+static void bench_single_rate(const struct device *dev)
+{
+	uint32_t samples = 0;
+	uint32_t errors = 0;
+	int64_t start = k_uptime_get();
+	int32_t value;
+
+	while (k_uptime_get() - start < BENCH_RUN_MS) {
+		if (hx711_read_raw(dev, &value) < 0) {
+			errors++;
+		} else {
+			samples++;
+		}
+	}
+
+	bench_report_rate("single", bench_transport(dev), 0, samples, errors,
+			  (uint32_t)(k_uptime_get() - start));
+}
+
+static int bench_wait_all(k_timeout_t timeout)
+{
+	for (uint8_t i = 0; i < bench_array.num_sensors; i++) {
+		int ret = hx711_wait_for_data(bench_array.sensors[i], timeout);
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* One lockstep hx711_array_read_raw() over every sensor */
+static void bench_frame(void)
+{
+	int32_t values[CONFIG_HX711_ARRAY_MAX_SENSORS];
+	uint32_t mask;
+	size_t n = 0;
+
+	while (n < BENCH_SAMPLES) {
+		if (bench_wait_all(BENCH_WAIT) < 0) {
+			printk("array: no data\n");
+			return;
+		}
+
+		/* The mask selects the members to clock and returns those read */
+		mask = BIT_MASK(bench_array.num_sensors);
+
+		bench_stamp_t start = bench_stamp();
+		int ret = hx711_array_read_raw(&bench_array, &mask, values);
+		bench_stamp_t end = bench_stamp();
+
+		/* A pass that clocked nothing is not a frame */
+		if (ret < 0 || mask == 0) {
+			continue;
+		}
+
+		bench_cycles[n] = bench_elapsed(start, end);
+		bench_bit_cycles[n] = bench_cycles[n] / BENCH_PULSES;
+		n++;
+	}
+
+	printk("# array of %u\n", bench_array.num_sensors);
+	bench_report("frame", "array", bench_cycles, n, BENCH_CLOCK, bench_hz());
+	bench_report("frame_bit", "array", bench_bit_cycles, n, BENCH_CLOCK, bench_hz());
+}
+
+static void bench_frame_rate(void)
+{
+	uint32_t samples[CONFIG_HX711_ARRAY_MAX_SENSORS] = {0};
+	int32_t values[CONFIG_HX711_ARRAY_MAX_SENSORS];
+	uint32_t errors = 0;
+	int64_t start = k_uptime_get();
+	uint32_t ms;
+	uint32_t mask;
+
+	while (k_uptime_get() - start < BENCH_RUN_MS) {
+		mask = BIT_MASK(bench_array.num_sensors);
+		if (bench_wait_all(BENCH_WAIT) < 0 ||
+		    hx711_array_read_raw(&bench_array, &mask, values) < 0) {
+			errors++;
+			continue;
+		}
+
+		for (uint8_t i = 0; i < bench_array.num_sensors; i++) {
+			if (mask & BIT(i)) {
+				samples[i]++;
+			}
+		}
+	}
+
+	ms = (uint32_t)(k_uptime_get() - start);
+	for (uint8_t i = 0; i < bench_array.num_sensors; i++) {
+		bench_report_rate("array", "array", i, samples[i], errors, ms);
+	}
+}
+
+#ifdef CONFIG_HX711_ASYNC
+#if DT_NODE_HAS_STATUS(DT_NODELABEL(hx711_0), okay)
+#define BENCH_ASYNC 1
+
+/* Submit and complete one RTIO read, including the wait for data-ready */
+SENSOR_DT_READ_IODEV(bench_iodev, DT_NODELABEL(hx711_0), {SENSOR_CHAN_HX711_RAW, 0});
+RTIO_DEFINE(bench_rtio, 1, 1);
+
+static void bench_async(void)
+{
+	uint8_t buf[sizeof(struct hx711_encoded_data)];
+	uint32_t errors = 0;
+	size_t n = 0;
+
+	while (n < BENCH_SAMPLES && errors < BENCH_SAMPLES) {
+		bench_stamp_t start = bench_stamp();
+		int ret = sensor_read(&bench_iodev, &bench_rtio, buf, sizeof(buf));
+		bench_stamp_t end = bench_stamp();
+
+		if (ret < 0) {
+			errors++;
+			continue;
+		}
+
+		bench_cycles[n++] = bench_elapsed(start, end);
+	}
+
+	printk("# %s async\n", DEVICE_DT_GET(DT_NODELABEL(hx711_0))->name);
+	bench_report("sensor_read", "rtio", bench_cycles, n, BENCH_CLOCK, bench_hz());
+}
+#endif
+#endif
+
+int main(void)
+{
+	int ret;
+
+	printk("HX711 acquisition benchmark, %u sensors, %s mode\n",
+	       (unsigned int)ARRAY_SIZE(bench_devs), BENCH_MODE);
+
+#ifdef CONFIG_TIMING_FUNCTIONS
+	timing_init();
+	timing_start();
+#endif
+
+	for (size_t i = 0; i < ARRAY_SIZE(bench_devs); i++) {
+		if (!device_is_ready(bench_devs[i])) {
+			printk("%s not ready\n", bench_devs[i]->name);
+			return -1;
+		}
+		hx711_set_rate(bench_devs[i], 80);
+	}
+
+	printk("BENCH,name,transport,mode,n,min,mean,p99,max,clock,hz\n");
+	printk("RATE,name,transport,mode,channel,samples,errors,ms,milli_sps\n");
+
+	for (size_t i = 0; i < ARRAY_SIZE(bench_devs); i++) {
+		bench_single(bench_devs[i]);
+		bench_single_rate(bench_devs[i]);
+	}
+
+	ret = hx711_array_init(&bench_array, bench_devs, ARRAY_SIZE(bench_devs));
+	if (ret < 0) {
+		printk("array: not supported by this wiring (%d)\n", ret);
+	} else {
+		bench_frame();
+		bench_frame_rate();
+	}
+
+#ifdef BENCH_ASYNC
+	bench_async();
+#endif
+
+	printk("BENCH_DONE\n");
+	return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replay throughput. Writes a synthetic capture (or takes --file), maps
+ * it, decodes it and runs the pipeline on 1 and on N threads, then checks
+ * every output against the firmware functions called one sample at a
+ * time. Exits 1 on any mismatch.
+ *
+ *   hx711_replay_bench [--frames N] [--channels N] [--threads N] [--file capture.bin]
+ */
+
+#include "hx711_replay.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace hx711;
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct options {
+	size_t frames = 2000000;
+	unsigned channels = 4;
+	unsigned threads = 0;
+	std::string file;
+};
+
+/* Deterministic, so runs compare */
+struct xorshift {
+	uint32_t state = 0x2545F491;
+
+	uint32_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+/* Load cell like: a drifting level with noise and the odd step, 24-bit */
+std::vector<uint8_t> synth_capture(const options &opt, std::vector<std::vector<int32_t>> &truth)
+{
+	std::vector<uint8_t> out;
+	std::vector<int32_t> level(opt.channels);
+	std::vector<int32_t> values(opt.channels);
+	xorshift rng;
+
+	out.reserve(opt.frames * (10 + 3 * opt.channels + 2));
+	truth.assign(opt.channels, std::vector<int32_t>());
+	for (unsigned ch = 0; ch < opt.channels; ch++) {
+		level[ch] = static_cast<int32_t>(ch * 100000) - 150000;
+		truth[ch].reserve(opt.frames);
+	}
+
+	for (size_t f = 0; f < opt.frames; f++) {
+		for (unsigned ch = 0; ch < opt.channels; ch++) {
+			int32_t noise = static_cast<int32_t>(rng.next() % 64) - 32;
+
+			if (rng.next() % 4096 == 0) {
+				level[ch] += static_cast<int32_t>(rng.next() % 200000) - 100000;
+			}
+			level[ch] += static_cast<int32_t>(rng.next() % 5) - 2;
+			level[ch] = std::max(-0x800000, std::min(0x7FFFFF, level[ch]));
+			values[ch] = std::max(-0x800000, std::min(0x7FFFFF, level[ch] + noise));
+			truth[ch].push_back(values[ch]);
+		}
+		encode_stream_frame(static_cast<uint16_t>(f), static_cast<uint32_t>(f * 409600),
+				    (1u << opt.channels) - 1, values.data(),
+				    static_cast<uint8_t>(opt.channels), out);
+	}
+
+	return out;
+}
+
+/* Exercise every kernel path: linear, gain corrected, piecewise, unfiltered */
+std::vector<channel_config> bench_configs(unsigned channels)
+{
+	static const hx711_calib_point points[] = {
+		{ -200000, -150000 }, { 0, 0 }, { 150000, 120000 }, { 400000, 330000 },
+	};
+	std::vector<channel_config> configs(channels);
+
+	for (unsigned ch = 0; ch < channels; ch++) {
+		channel_config &cfg = configs[ch];
+
+		cfg.filter = (ch % 4) != 3;
+		cfg.filter_cfg.median = 5;
+		cfg.filter_cfg.average = 8;
+		cfg.filter_cfg.iir_shift = 2;
+		cfg.filter_cfg.decimate = 4;
+		/* About fs / 10, Q2.14 */
+		cfg.filter_cfg.biquad = true;
+		cfg.filter_cfg.biquad_q14[0] = 1106;
+		cfg.filter_cfg.biquad_q14[1] = 2212;
+		cfg.filter_cfg.biquad_q14[2] = 1106;
+		cfg.filter_cfg.biquad_q14[3] = -18727;
+		cfg.filter_cfg.biquad_q14[4] = 6763;
+
+		cfg.calibrate = true;
+		(void)hx711_calib_init(&cfg.calib, 128, static_cast<int32_t>(ch) * 1000, 2345);
+		cfg.gain = (ch % 4) == 1 ? 64 : 128;
+		if ((ch % 4) == 2) {
+			(void)hx711_calib_set_points(&cfg.calib, points, 4);
+		}
+	}
+
+	return configs;
+}
+
+/* The firmware functions, one sample at a time, as the acquisition thread runs them */
+size_t verify(const stream_frames &frames, const std::vector<channel_config> &configs,
+	      const std::vector<channel_output> &out)
+{
+	size_t mismatches = 0;
+
+	for (size_t ch = 0; ch < frames.channels; ch++) {
+		const channel_config &cfg = configs[ch];
+		const std::vector<int32_t> &in = frames.values[ch];
+		hx711_filter filter;
+		size_t n = 0;
+
+		hx711_filter_init(&filter, &cfg.filter_cfg);
+		for (size_t i = 0; i < in.size(); i++) {
+			int32_t v = in[i];
+
+			if (cfg.filter && !hx711_filter_run(&filter, in[i], &v)) {
+				continue;
+			}
+
+			if (n >= out[ch].counts.size() || out[ch].frame[n] != i ||
+			    out[ch].counts[n] != v ||
+			    (cfg.calibrate &&
+			     out[ch].load[n] != hx711_calib_apply(&cfg.calib, v, cfg.gain))) {
+				mismatches++;
+			}
+			n++;
+		}
+		mismatches += out[ch].counts.size() - std::min(n, out[ch].counts.size());
+	}
+
+	return mismatches;
+}
+
+double seconds_since(bench_clock::time_point start)
+{
+	return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(const char *what, size_t samples, double secs)
+{
+	std::printf("%-24s %8.3f s %10.2f Msamples/s\n", what, secs, samples / secs / 1e6);
+}
+
+bool parse(int argc, char **argv, options &opt)
+{
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+
+		if (i + 1 >= argc) {
+			return false;
+		}
+		if (std::strcmp(arg, "--frames") == 0) {
+			opt.frames = std::strtoull(argv[++i], nullptr, 0);
+		} else if (std::strcmp(arg, "--channels") == 0) {
+			opt.channels = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+		} else if (std::strcmp(arg, "--threads") == 0) {
+			opt.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+		} else if (std::strcmp(arg, "--file") == 0) {
+			opt.file = argv[++i];
+		} else {
+			return false;
+		}
+	}
+
+	return opt.channels >= 1 && opt.channels <= 32;
+}
+
+} /* namespace */
+
+int main(int argc, char **argv)
+{
+	options opt;
+	std::vector<std::vector<int32_t>> truth;
+	std::string path;
+	bench_clock::time_point start;
+	size_t samples;
+	size_t mismatches = 0;
+
+	if (!parse(argc, argv, opt)) {
+		std::fprintf(stderr, "usage: %s [--frames N] [--channels N] [--threads N] "
+			     "[--file capture.bin]\n", argv[0]);
+		return 2;
+	}
+	if (opt.threads == 0) {
+		opt.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	path = opt.file;
+	if (path.empty()) {
+		char tmpl[] = "/tmp/hx711_replay_XXXXXX";
+		int fd = mkstemp(tmpl);
+		std::vector<uint8_t> capture;
+
+		if (fd < 0) {
+			std::perror("mkstemp");
+			return 2;
+		}
+		capture = synth_capture(opt, truth);
+		if (write(fd, capture.data(), capture.size()) != static_cast<ssize_t>(capture.size())) {
+			std::perror("write");
+			close(fd);
+			unlink(tmpl);
+			return 2;
+		}
+		close(fd);
+		path = tmpl;
+	}
+
+	mapped_file file(path);
+	if (opt.file.empty()) {
+		/* Mapped already, the name is not needed any more */
+		unlink(path.c_str());
+	}
+
+	std::printf("%s: %zu bytes, %u threads\n", opt.file.empty() ? "synthetic" : path.c_str(),
+		    file.size(), opt.threads);
+
+	start = bench_clock::now();
+	stream_frames frames = decode_stream(file.data(), file.size(), 1);
+	double decode_1 = seconds_since(start);
+
+	start = bench_clock::now();
+	stream_frames frames_n = decode_stream(file.data(), file.size(), opt.threads);
+	double decode_n = seconds_since(start);
+
+	samples = frames.size() * frames.channels;
+	std::printf("%zu frames x %u channels, %zu bad, %zu lost\n", frames.size(),
+		    frames.channels, frames.bad, frames.lost);
+	if (samples == 0) {
+		return 1;
+	}
+
+	std::vector<channel_config> configs = bench_configs(frames.channels);
+
+	start = bench_clock::now();
+	std::vector<channel_output> out_1 = run_pipeline(frames, configs, 1);
+	double pipe_1 = seconds_since(start);
+
+	start = bench_clock::now();
+	std::vector<channel_output> out_n = run_pipeline(frames, configs, opt.threads);
+	double pipe_n = seconds_since(start);
+
+	std::vector<int32_t> calib_out(frames.values[0].size());
+	start = bench_clock::now();
+	calib_apply(configs[0].calib, configs[0].gain, frames.values[0].data(), calib_out.data(),
+		    calib_out.size());
+	double calib_1 = seconds_since(start);
+
+	report("decode, 1 thread", samples, decode_1);
+	report("decode, N threads", samples, decode_n);
+	report("pipeline, 1 thread", samples, pipe_1);
+	report("pipeline, N threads", samples, pipe_n);
+	report("calibrate only", calib_out.size(), calib_1);
+
+	/* Everything below must hold exactly */
+	if (frames_n.size() != frames.size() || frames_n.values != frames.values) {
+		std::printf("threaded decode differs\n");
+		mismatches++;
+	}
+	if (!truth.empty() && truth != frames.values) {
+		std::printf("decoded values differ from the synthetic input\n");
+		mismatches++;
+	}
+	for (size_t i = 0; i < calib_out.size(); i++) {
+		if (calib_out[i] != hx711_calib_apply(&configs[0].calib, frames.values[0][i],
+						      configs[0].gain)) {
+			mismatches++;
+		}
+	}
+	mismatches += verify(frames, configs, out_1);
+	mismatches += verify(frames, configs, out_n);
+
+	std::printf("verify: %s (%zu mismatches)\n", mismatches == 0 ? "bit exact" : "FAILED",
+		    mismatches);
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_REPLAY_HPP_
+#define HX711_REPLAY_HPP_
+
+#include "hx711_calib.h"
+#include "hx711_core.h"
+#include "hx711_filter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Host replay of captured HX711 streams. The conversion math is the
+ * firmware's own: hx711_core.h, hx711_calib.c and hx711_filter.c build
+ * into this library unchanged, with the Kconfig sizes passed in by CMake,
+ * so a channel fed the conversions the device saw gives the device's
+ * outputs bit for bit.
+ *
+ * Data is kept as structure of arrays, one contiguous vector per channel,
+ * so the per-sample kernels are plain loops the compiler vectorizes and
+ * channels are processed on separate threads.
+ */
+namespace hx711 {
+
+/* Read-only memory mapping of a whole file */
+class mapped_file {
+public:
+	mapped_file() = default;
+	explicit mapped_file(const std::string &path);
+	~mapped_file();
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file &operator=(const mapped_file &) = delete;
+	mapped_file(mapped_file &&other) noexcept;
+	mapped_file &operator=(mapped_file &&other) noexcept;
+
+	const uint8_t *data() const { return data_; }
+	size_t size() const { return size_; }
+
+private:
+	const uint8_t *data_ = nullptr;
+	size_t size_ = 0;
+};
+
+/* Frames of the binary stream (src/hx711_stream.h), one vector per field */
+struct stream_frames {
+	uint8_t channels = 0;
+	std::vector<uint16_t> seq;
+	std::vector<uint32_t> timestamp;  /* Cycle count of the grid point */
+	std::vector<uint32_t> fresh;      /* Bit n set when channel n was interpolated */
+	std::vector<std::vector<int32_t>> values; /* values[channel][frame] */
+	size_t bad = 0;                   /* Frames dropped for COBS, CRC or layout errors */
+	size_t lost = 0;                  /* Gaps in the sequence numbers */
+
+	size_t size() const { return seq.size(); }
+};
+
+/*
+ * Decode a raw capture, COBS records separated by 0x00 as written by
+ * hx711_stream.c. The buffer is split at record boundaries and the parts
+ * decoded on up to threads threads, 0 for one per hardware thread.
+ * Frames whose channel count differs from the first good frame are
+ * counted bad.
+ */
+stream_frames decode_stream(const uint8_t *data, size_t len, unsigned threads = 0);
+
+/* Encode one frame the way hx711_stream.c does, for tests and benchmarks */
+void encode_stream_frame(uint16_t seq, uint32_t timestamp, uint32_t fresh,
+			 const int32_t *values, uint8_t channels, std::vector<uint8_t> &out);
+
+/* Per-channel pipeline, the acquisition thread's filter chain then calibration */
+struct channel_config {
+	bool filter = false;
+	hx711_filter_config filter_cfg = {};
+	bool calibrate = false;
+	hx711_calib calib = {};
+	uint8_t gain = 128;               /* Gain the conversions were taken at */
+};
+
+struct channel_output {
+	std::vector<uint32_t> frame;      /* Input index of every output */
+	std::vector<int32_t> counts;      /* Filter output, decimated */
+	std::vector<int32_t> load;        /* Calibrated, empty without calibrate */
+};
+
+/* Kernels, each equal to its scalar firmware function on every element */
+void sign_extend(const int32_t *in, int32_t *out, size_t n);
+void calib_apply(const hx711_calib &calib, uint8_t gain, const int32_t *in, int32_t *out,
+		 size_t n);
+
+/* Run a fresh filter over in, appending its outputs */
+void filter_run(const hx711_filter_config &cfg, const int32_t *in, size_t n,
+		channel_output &out);
+
+/*
+ * Run every channel of frames through its config, channels spread over up
+ * to threads threads, 0 for one per hardware thread. configs holds one
+ * entry per channel.
+ */
+std::vector<channel_output> run_pipeline(const stream_frames &frames,
+					 const std::vector<channel_config> &configs,
+					 unsigned threads = 0);
+
+} /* namespace hx711 */
+
+#endif /* HX711_REPLAY_HPP_ */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace hx711 {
+
+void sign_extend(const int32_t *in, int32_t *out, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		out[i] = hx711_sign_extend(in[i]);
+	}
+}
+
+/*
+ * hx711_calib_apply() over an array. The linear case is hoisted out of the
+ * per-sample branches into loops of 64-bit multiplies and shifts, which
+ * vectorize; a piecewise table calls the firmware function per sample.
+ */
+void calib_apply(const hx711_calib &calib, uint8_t gain, const int32_t *in, int32_t *out,
+		 size_t n)
+{
+	int idx = hx711_calib_gain_index(gain);
+	const int64_t offset = calib.offset;
+	const int64_t scale = calib.scale_q16;
+
+	if (calib.num_points >= 2) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = hx711_calib_apply(&calib, in[i], gain);
+		}
+		return;
+	}
+
+	if (gain != calib.ref_gain && idx >= 0) {
+		const int64_t corr = calib.gain_corr_q16[idx];
+
+		for (size_t i = 0; i < n; i++) {
+			int64_t counts = ((in[i] - offset) * corr) >> HX711_CALIB_Q;
+
+			out[i] = hx711_clamp_s32((counts * scale) >> HX711_CALIB_Q, -INT32_MAX,
+						 INT32_MAX);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		out[i] = hx711_clamp_s32(((in[i] - offset) * scale) >> HX711_CALIB_Q, -INT32_MAX,
+					 INT32_MAX);
+	}
+}
+
+/* The stages carry state from one sample to the next, so this is the
+ * firmware's hx711_filter_run() itself, sample by sample
+ */
+void filter_run(const hx711_filter_config &cfg, const int32_t *in, size_t n,
+		channel_output &out)
+{
+	hx711_filter filter;
+	size_t expect = n / std::max<size_t>(cfg.decimate, 1) + 1;
+
+	hx711_filter_init(&filter, &cfg);
+	out.frame.reserve(out.frame.size() + expect);
+	out.counts.reserve(out.counts.size() + expect);
+
+	for (size_t i = 0; i < n; i++) {
+		int32_t v;
+
+		if (hx711_filter_run(&filter, in[i], &v)) {
+			out.frame.push_back(static_cast<uint32_t>(i));
+			out.counts.push_back(v);
+		}
+	}
+}
+
+static void run_channel(const std::vector<int32_t> &in, const channel_config &cfg,
+			channel_output &out)
+{
+	if (cfg.filter) {
+		filter_run(cfg.filter_cfg, in.data(), in.size(), out);
+	} else {
+		out.frame.resize(in.size());
+		for (size_t i = 0; i < in.size(); i++) {
+			out.frame[i] = static_cast<uint32_t>(i);
+		}
+		out.counts = in;
+	}
+
+	if (cfg.calibrate) {
+		out.load.resize(out.counts.size());
+		calib_apply(cfg.calib, cfg.gain, out.counts.data(), out.load.data(),
+			    out.counts.size());
+	}
+}
+
+std::vector<channel_output> run_pipeline(const stream_frames &frames,
+					 const std::vector<channel_config> &configs,
+					 unsigned threads)
+{
+	std::vector<channel_output> out(frames.channels);
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next{0};
+	size_t channels = std::min<size_t>(frames.channels, configs.size());
+
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/* A channel is one thread's work, the chain is sequential within it */
+	auto worker = [&]() {
+		for (size_t ch = next++; ch < channels; ch = next++) {
+			run_channel(frames.values[ch], configs[ch], out[ch]);
+		}
+	};
+
+	for (unsigned t = 0; t < std::min<size_t>(threads, channels); t++) {
+		workers.emplace_back(worker);
+	}
+	for (auto &w : workers) {
+		w.join();
+	}
+
+	return out;
+}
+
+} /* namespace hx711 */
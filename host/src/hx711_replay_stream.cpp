@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_replay.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hx711 {
+
+/* src/hx711_stream.h */
+static constexpr uint8_t stream_version = 2;
+static constexpr size_t stream_max_channels = 32;
+static constexpr size_t stream_max_frame = 8 + 4 + 3 * stream_max_channels + 2;
+/* One code byte per 254 data bytes, plus the first */
+static constexpr size_t stream_max_encoded = stream_max_frame + stream_max_frame / 254 + 1;
+
+mapped_file::mapped_file(const std::string &path)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat st;
+
+	if (fd < 0) {
+		throw std::system_error(errno, std::generic_category(), path);
+	}
+
+	if (::fstat(fd, &st) < 0) {
+		int err = errno;
+
+		::close(fd);
+		throw std::system_error(err, std::generic_category(), path);
+	}
+
+	size_ = static_cast<size_t>(st.st_size);
+	if (size_ > 0) {
+		void *map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (map == MAP_FAILED) {
+			int err = errno;
+
+			::close(fd);
+			throw std::system_error(err, std::generic_category(), path);
+		}
+		/* Decoding is one pass front to back */
+		(void)::madvise(map, size_, MADV_SEQUENTIAL);
+		data_ = static_cast<const uint8_t *>(map);
+	}
+
+	/* The mapping holds its own reference to the file */
+	::close(fd);
+}
+
+mapped_file::~mapped_file()
+{
+	if (data_ != nullptr) {
+		::munmap(const_cast<uint8_t *>(data_), size_);
+	}
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept
+	: data_(other.data_), size_(other.size_)
+{
+	other.data_ = nullptr;
+	other.size_ = 0;
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&other) noexcept
+{
+	std::swap(data_, other.data_);
+	std::swap(size_, other.size_);
+	return *this;
+}
+
+/* Zephyr crc16_ccitt(), reflected polynomial 0x8408, no final XOR */
+static uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uint8_t e = static_cast<uint8_t>(seed ^ src[i]);
+		uint8_t f = static_cast<uint8_t>(e ^ (e << 4));
+
+		seed = static_cast<uint16_t>((seed >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4));
+	}
+
+	return seed;
+}
+
+/* Returns the decoded length, 0 for a malformed record */
+static size_t cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t size)
+{
+	size_t out_len = 0;
+	size_t i = 0;
+
+	while (i < len) {
+		uint8_t code = in[i];
+
+		if (code == 0 || i + code > len || out_len + code > size) {
+			return 0;
+		}
+		std::memcpy(&out[out_len], &in[i + 1], code - 1);
+		out_len += code - 1;
+		i += code;
+		if (code < 0xFF && i < len) {
+			out[out_len++] = 0;
+		}
+	}
+
+	return out_len;
+}
+
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out)
+{
+	size_t code_idx = 0;
+	size_t out_len = 1;
+	uint8_t code = 1;
+
+	for (size_t i = 0; i < len; i++) {
+		if (in[i] == 0) {
+			out[code_idx] = code;
+			code_idx = out_len++;
+			code = 1;
+			continue;
+		}
+
+		out[out_len++] = in[i];
+		if (++code == 0xFF) {
+			out[code_idx] = code;
+			code_idx = out_len++;
+			code = 1;
+		}
+	}
+
+	out[code_idx] = code;
+
+	return out_len;
+}
+
+static uint32_t get_le(const uint8_t *p, size_t bytes)
+{
+	uint32_t v = 0;
+
+	for (size_t i = 0; i < bytes; i++) {
+		v |= static_cast<uint32_t>(p[i]) << (8 * i);
+	}
+
+	return v;
+}
+
+static bool parse_frame(const uint8_t *frame, size_t len, stream_frames &out)
+{
+	size_t mask_len;
+	size_t pos = 8;
+	uint8_t channels;
+
+	if (len < 10 || frame[0] != stream_version) {
+		return false;
+	}
+
+	if (crc16_ccitt(0xFFFF, frame, len - 2) != get_le(&frame[len - 2], 2)) {
+		return false;
+	}
+
+	channels = frame[1];
+	mask_len = (channels + 7) / 8;
+	if (channels == 0 || channels > stream_max_channels ||
+	    len != pos + mask_len + 3 * channels + 2) {
+		return false;
+	}
+
+	if (out.channels == 0) {
+		out.channels = channels;
+		out.values.resize(channels);
+	} else if (channels != out.channels) {
+		return false;
+	}
+
+	out.seq.push_back(static_cast<uint16_t>(get_le(&frame[2], 2)));
+	out.timestamp.push_back(get_le(&frame[4], 4));
+	out.fresh.push_back(get_le(&frame[pos], mask_len));
+	pos += mask_len;
+
+	/* Sign extension runs over whole channels once decoding is done */
+	for (uint8_t ch = 0; ch < channels; ch++) {
+		out.values[ch].push_back(static_cast<int32_t>(get_le(&frame[pos], 3)));
+		pos += 3;
+	}
+
+	return true;
+}
+
+static void decode_part(const uint8_t *data, size_t len, stream_frames &out)
+{
+	uint8_t frame[stream_max_frame];
+	size_t start = 0;
+
+	/* Roughly one frame per 20 bytes for a few channels, saves regrowth */
+	out.seq.reserve(len / 20);
+	out.timestamp.reserve(len / 20);
+	out.fresh.reserve(len / 20);
+
+	while (start < len) {
+		const uint8_t *end = static_cast<const uint8_t *>(
+			std::memchr(&data[start], 0, len - start));
+		size_t rec_len = (end != nullptr ? end - data : len) - start;
+
+		/* A capture cut mid-record leaves its tail unterminated */
+		if (end == nullptr) {
+			out.bad++;
+			break;
+		}
+
+		if (rec_len > 0) {
+			size_t frame_len = rec_len <= stream_max_encoded ?
+					   cobs_decode(&data[start], rec_len, frame, sizeof(frame)) : 0;
+
+			if (frame_len == 0 || !parse_frame(frame, frame_len, out)) {
+				out.bad++;
+			}
+		}
+		start += rec_len + 1;
+	}
+}
+
+static void append(stream_frames &dst, const stream_frames &src)
+{
+	if (src.channels == 0) {
+		dst.bad += src.bad;
+		return;
+	}
+
+	if (dst.channels == 0) {
+		dst.channels = src.channels;
+		dst.values.resize(src.channels);
+	} else if (dst.channels != src.channels) {
+		/* The whole part disagrees with the capture's first frame */
+		dst.bad += src.bad + src.size();
+		return;
+	}
+
+	dst.seq.insert(dst.seq.end(), src.seq.begin(), src.seq.end());
+	dst.timestamp.insert(dst.timestamp.end(), src.timestamp.begin(), src.timestamp.end());
+	dst.fresh.insert(dst.fresh.end(), src.fresh.begin(), src.fresh.end());
+	for (uint8_t ch = 0; ch < dst.channels; ch++) {
+		dst.values[ch].insert(dst.values[ch].end(), src.values[ch].begin(),
+				      src.values[ch].end());
+	}
+	dst.bad += src.bad;
+}
+
+stream_frames decode_stream(const uint8_t *data, size_t len, unsigned threads)
+{
+	std::vector<stream_frames> parts;
+	std::vector<std::thread> workers;
+	std::vector<size_t> bounds;
+	stream_frames out;
+
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/* Parts start right after a record delimiter */
+	bounds.push_back(0);
+	for (unsigned t = 1; t < threads; t++) {
+		size_t at = std::max(bounds.back(), len / threads * t);
+		const void *zero = at < len ? std::memchr(&data[at], 0, len - at) : nullptr;
+
+		if (zero == nullptr) {
+			break;
+		}
+		bounds.push_back(static_cast<const uint8_t *>(zero) - data + 1);
+	}
+	bounds.push_back(len);
+
+	parts.resize(bounds.size() - 1);
+	for (size_t p = 0; p < parts.size(); p++) {
+		workers.emplace_back(decode_part, &data[bounds[p]], bounds[p + 1] - bounds[p],
+				     std::ref(parts[p]));
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	for (const auto &part : parts) {
+		append(out, part);
+	}
+
+	for (auto &channel : out.values) {
+		sign_extend(channel.data(), channel.data(), channel.size());
+	}
+
+	for (size_t i = 1; i < out.size(); i++) {
+		out.lost += static_cast<uint16_t>(out.seq[i] - out.seq[i - 1] - 1);
+	}
+
+	return out;
+}
+
+void encode_stream_frame(uint16_t seq, uint32_t timestamp, uint32_t fresh,
+			 const int32_t *values, uint8_t channels, std::vector<uint8_t> &out)
+{
+	uint8_t frame[stream_max_frame];
+	uint8_t encoded[stream_max_encoded];
+	size_t len = 0;
+	uint16_t crc;
+
+	channels = std::min<uint8_t>(channels, stream_max_channels);
+	frame[len++] = stream_version;
+	frame[len++] = channels;
+	frame[len++] = static_cast<uint8_t>(seq);
+	frame[len++] = static_cast<uint8_t>(seq >> 8);
+	for (size_t i = 0; i < 4; i++) {
+		frame[len++] = static_cast<uint8_t>(timestamp >> (8 * i));
+	}
+	for (size_t i = 0; i < (channels + 7u) / 8; i++) {
+		frame[len++] = static_cast<uint8_t>(fresh >> (8 * i));
+	}
+	for (uint8_t ch = 0; ch < channels; ch++) {
+		for (size_t i = 0; i < 3; i++) {
+			frame[len++] = static_cast<uint8_t>(static_cast<uint32_t>(values[ch]) >> (8 * i));
+		}
+	}
+
+	crc = crc16_ccitt(0xFFFF, frame, len);
+	frame[len++] = static_cast<uint8_t>(crc);
+	frame[len++] = static_cast<uint8_t>(crc >> 8);
+
+	len = cobs_encode(frame, len, encoded);
+	out.insert(out.end(), encoded, encoded + len);
+	out.push_back(0x00);
+}
+
+} /* namespace hx711 */
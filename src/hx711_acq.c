@@ -0,0 +1,1084 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_acq.h"
+#include "hx711_adapt.h"
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#ifdef CONFIG_HX711_SHELL
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_REGISTER(hx711_acq, LOG_LEVEL_INF);
+
+/* A group is the sensors that share an SCK port and a DOUT port */
+struct hx711_acq_group {
+	struct hx711_array array;
+	uint8_t index[CONFIG_HX711_ARRAY_MAX_SENSORS]; /* Sensor index of array member n */
+};
+
+static const struct device *acq_sensors[CONFIG_HX711_ACQ_MAX_SENSORS];
+static uint8_t acq_num_sensors;
+static struct hx711_acq_group acq_groups[CONFIG_HX711_ACQ_MAX_GROUPS];
+static uint8_t acq_num_groups;
+static bool acq_started;
+static struct hx711_ring *acq_rings[CONFIG_HX711_ACQ_MAX_CONSUMERS];
+static size_t acq_num_rings;
+static uint32_t acq_full_rate; /* Rings that take every conversion, not the decimated ones */
+#ifdef CONFIG_HX711_FILTER
+static struct hx711_filter acq_filters[HX711_ACQ_MAX_CHANNELS];
+#endif
+#ifdef CONFIG_HX711_TRIGGER
+static struct k_poll_event acq_drdy_events[CONFIG_HX711_ACQ_MAX_SENSORS];
+#endif
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+K_TIMER_DEFINE(acq_duty_timer, NULL, NULL);
+#endif
+/* Over two conversion periods at 10 SPS */
+#define HX711_ACQ_TIMEOUT_MS 250
+/* Channel A at 10 SPS, every other conversion while scanning */
+#define HX711_ACQ_MEAN_SAMPLE_MS 200
+static uint32_t acq_seen[CONFIG_HX711_ACQ_MAX_SENSORS]; /* Uptime of the last data-ready */
+static uint32_t acq_quarantined; /* Sensors left out of the loop until a probe succeeds */
+#ifdef CONFIG_HX711_ACQ_HEALTH
+struct hx711_acq_health {
+	uint8_t timeouts;       /* In a row */
+	uint8_t repeats;        /* Dead-link codes in a row equal to last */
+	uint8_t probes;         /* Failed probes since the last power cycle */
+	bool stuck;             /* Quarantined for repeats, a probe must read a live code */
+	int32_t last;
+	k_timepoint_t probe_at;
+};
+
+static struct hx711_acq_health acq_health[CONFIG_HX711_ACQ_MAX_SENSORS];
+#endif
+/* One hx711_acq_mean() at a time, summed by the acquisition thread */
+struct hx711_acq_mean_req {
+	uint8_t sensor;
+	uint16_t left;
+	int64_t sum;
+};
+
+static K_MUTEX_DEFINE(acq_mean_lock);
+static K_SEM_DEFINE(acq_mean_done, 0, 1);
+static struct hx711_acq_mean_req acq_mean;
+static atomic_t acq_mean_armed;
+#ifdef CONFIG_HX711_ADAPT
+static struct hx711_adapt acq_adapt[CONFIG_HX711_ACQ_MAX_SENSORS];
+static uint32_t acq_adapt_sensors; /* RATE wired, channel A only, started at 80 SPS */
+static uint32_t acq_adapt_quiet;   /* Of those, the ones below the idle noise */
+static k_timepoint_t acq_idle_at;  /* Everyone quiet long enough to go idle */
+static bool acq_idle;
+#endif
+
+static void hx711_acq_publish(const struct hx711_sample *sample, bool full_rate)
+{
+	for (size_t i = 0; i < acq_num_rings; i++) {
+		if (((acq_full_rate & BIT(i)) != 0) == full_rate) {
+			hx711_ring_put(acq_rings[i], sample);
+		}
+	}
+}
+
+/* Returns false when the filter chain holds the sample back */
+static bool hx711_acq_filter(struct hx711_sample *sample)
+{
+#ifdef CONFIG_HX711_FILTER
+	struct hx711_filter *filter = &acq_filters[sample->sensor_id];
+
+	if (sample->status & HX711_SAMPLE_ERROR) {
+		/* Do not smear a glitch across the next outputs */
+		hx711_filter_reset(filter);
+		return true;
+	}
+
+	return hx711_filter_run(filter, sample->raw, &sample->raw);
+#else
+	ARG_UNUSED(sample);
+	return true;
+#endif
+}
+
+/* Full-rate copy of a sample the filter chain just ran on */
+static void hx711_acq_low_pass(struct hx711_sample *sample)
+{
+#ifdef CONFIG_HX711_FILTER
+	if (!(sample->status & HX711_SAMPLE_ERROR)) {
+		sample->raw = acq_filters[sample->sensor_id].value;
+	}
+#else
+	ARG_UNUSED(sample);
+#endif
+}
+
+#ifdef CONFIG_HX711_ADAPT
+/* The adaptive sensors switch together, the grid only widens when all are idle */
+static void hx711_acq_set_idle(bool idle)
+{
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		if (acq_adapt_sensors & BIT(i)) {
+			(void)hx711_set_rate(acq_sensors[i], idle ? 10 : 80);
+			hx711_adapt_set_idle(&acq_adapt[i], idle);
+		}
+	}
+
+	acq_idle = idle;
+	acq_adapt_quiet = 0;
+}
+
+/* Runs on every valid conversion of an adaptive sensor, after the low-pass stages */
+static void hx711_acq_adapt(uint8_t sensor, int32_t value)
+{
+	/* A quarantined sensor does not hold the others at 80 SPS */
+	uint32_t watched = acq_adapt_sensors & ~acq_quarantined;
+	enum hx711_adapt_level level;
+
+	if (!(acq_adapt_sensors & BIT(sensor))) {
+		return;
+	}
+
+	level = hx711_adapt_update(&acq_adapt[sensor], value);
+
+	/* One change on any sensor brings them all back */
+	if (acq_idle) {
+		if (level == HX711_ADAPT_CHANGE) {
+			hx711_acq_set_idle(false);
+		}
+		return;
+	}
+
+	if (level != HX711_ADAPT_QUIET) {
+		acq_adapt_quiet &= ~BIT(sensor);
+		return;
+	}
+
+	if (!(acq_adapt_quiet & BIT(sensor))) {
+		acq_adapt_quiet |= BIT(sensor);
+		/* The hold time runs from the last sensor to quieten */
+		if ((acq_adapt_quiet & watched) == watched) {
+			acq_idle_at = sys_timepoint_calc(K_MSEC(CONFIG_HX711_ADAPT_IDLE_MS));
+		}
+		return;
+	}
+
+	if ((acq_adapt_quiet & watched) == watched && sys_timepoint_expired(acq_idle_at)) {
+		hx711_acq_set_idle(true);
+	}
+}
+
+static void hx711_acq_adapt_init(void)
+{
+	acq_adapt_sensors = 0;
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		const struct hx711_config *cfg = acq_sensors[i]->config;
+		const struct hx711_data *hx711 = acq_sensors[i]->data;
+
+		/* A scanning sensor drives RATE per channel, a 10 SPS one is already idle */
+		if (cfg->rate.port != NULL && !hx711->scan && hx711->rate_sps == 80) {
+			acq_adapt_sensors |= BIT(i);
+			hx711_adapt_reset(&acq_adapt[i]);
+		}
+	}
+}
+#endif /* CONFIG_HX711_ADAPT */
+
+/* Flags of a valid conversion of the sensor */
+static uint8_t hx711_acq_status(uint8_t sensor)
+{
+#ifdef CONFIG_HX711_ADAPT
+	if (acq_idle && (acq_adapt_sensors & BIT(sensor))) {
+		return HX711_SAMPLE_IDLE;
+	}
+#else
+	ARG_UNUSED(sensor);
+#endif
+	return 0;
+}
+
+/* Channel B conversions of a scanning sensor get their own channel */
+static uint8_t hx711_acq_channel(uint8_t sensor)
+{
+	const struct hx711_data *hx711 = acq_sensors[sensor]->data;
+
+	if (hx711->scan && hx711_last_gain(acq_sensors[sensor]) == 32) {
+		return acq_num_sensors + sensor;
+	}
+
+	return sensor;
+}
+
+size_t hx711_acq_num_channels(void)
+{
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		const struct hx711_data *hx711 = acq_sensors[i]->data;
+
+		if (hx711->scan) {
+			return 2 * acq_num_sensors;
+		}
+	}
+
+	return acq_num_sensors;
+}
+
+uint32_t hx711_acq_quarantined(void)
+{
+	return acq_quarantined;
+}
+
+int32_t hx711_acq_load(uint8_t channel, int32_t counts)
+{
+	const struct device *dev;
+	struct hx711_data *hx711;
+
+	/* The calibration is for channel A */
+	if (channel >= acq_num_sensors) {
+		return counts;
+	}
+
+	dev = acq_sensors[channel];
+	hx711 = dev->data;
+
+	return hx711_load(dev, counts, hx711->scan ? hx711->gain_a : hx711_last_gain(dev));
+}
+
+#ifdef CONFIG_HX711_ACQ_HEALTH
+/* The data-ready edges of a quarantined sensor no longer wake the thread */
+static void hx711_acq_watch(uint8_t sensor, bool watch)
+{
+#ifdef CONFIG_HX711_TRIGGER
+	struct hx711_data *hx711 = acq_sensors[sensor]->data;
+
+	k_poll_event_init(&acq_drdy_events[sensor],
+			  watch ? K_POLL_TYPE_SEM_AVAILABLE : K_POLL_TYPE_IGNORE,
+			  K_POLL_MODE_NOTIFY_ONLY, watch ? &hx711->drdy_sem : NULL);
+#else
+	ARG_UNUSED(sensor);
+	ARG_UNUSED(watch);
+#endif
+}
+
+static void hx711_acq_quarantine(uint8_t sensor, bool stuck)
+{
+	const struct device *dev = acq_sensors[sensor];
+	struct hx711_data *hx711 = dev->data;
+	struct hx711_acq_health *health = &acq_health[sensor];
+	struct hx711_sample sample = {
+		.timestamp = k_cycle_get_32(),
+		.raw = -ENODEV,
+		.sensor_id = sensor,
+		.status = HX711_SAMPLE_ERROR,
+	};
+
+	acq_quarantined |= BIT(sensor);
+	health->stuck = stuck;
+	health->probes = 0;
+	health->probe_at = sys_timepoint_calc(K_MSEC(CONFIG_HX711_ACQ_PROBE_MS));
+	hx711_acq_watch(sensor, false);
+	HX711_STATS_INC(&hx711->stats, quarantines);
+
+	/* Consumers see the channels fail once rather than go quiet */
+	for (uint8_t n = 0; n < (hx711->scan ? 2 : 1); n++) {
+		hx711_acq_publish(&sample, false);
+		hx711_acq_publish(&sample, true);
+		sample.sensor_id += acq_num_sensors;
+	}
+
+	/* Deferred, the console never holds up the other sensors */
+	LOG_WRN("%s: quarantined, %s", dev->name, stuck ? "stuck output" : "no data-ready");
+}
+
+static void hx711_acq_restore(uint8_t sensor, int32_t value)
+{
+	struct hx711_acq_health *health = &acq_health[sensor];
+
+	acq_quarantined &= ~BIT(sensor);
+	health->timeouts = 0;
+	health->repeats = 0;
+	health->last = value;
+	acq_seen[sensor] = k_uptime_get_32();
+	hx711_acq_watch(sensor, true);
+#ifdef CONFIG_HX711_FILTER
+	/* Nothing from before the fault is carried into the new outputs */
+	hx711_filter_reset(&acq_filters[sensor]);
+	hx711_filter_reset(&acq_filters[acq_num_sensors + sensor]);
+#endif
+
+	LOG_INF("%s: restored", acq_sensors[sensor]->name);
+}
+
+/* Codes of a dead link, all ones from a DOUT that reads high and all
+ * zeros from one pinned low. An overload holds 0x7FFFFF or 0x800000
+ * instead, stays in the loop and is counted as saturated.
+ */
+static bool hx711_acq_dead_code(int32_t value)
+{
+	return value == -1 || value == 0;
+}
+
+/* Runs on every valid conversion, a sensor stuck on a dead-link code is
+ * as dead as one that never signals data-ready
+ */
+static void hx711_acq_check_stuck(uint8_t sensor, int32_t value)
+{
+	struct hx711_acq_health *health = &acq_health[sensor];
+
+	if (CONFIG_HX711_ACQ_HEALTH_STUCK == 0) {
+		return;
+	}
+
+	if (!hx711_acq_dead_code(value) || value != health->last) {
+		health->last = value;
+		health->repeats = 0;
+		return;
+	}
+
+	if (++health->repeats >= CONFIG_HX711_ACQ_HEALTH_STUCK - 1) {
+		hx711_acq_quarantine(sensor, true);
+	}
+}
+
+/*
+ * Clock one conversion out of every quarantined sensor whose probe is due.
+ * Only the probed member of its group is read, and only when it signals
+ * data-ready, so a dead sensor costs a pin read per probe interval. A
+ * sensor that keeps failing is power-cycled through SCK, which clears a
+ * latched-up serial interface.
+ */
+static void hx711_acq_probe(void)
+{
+	for (uint8_t g = 0; g < acq_num_groups; g++) {
+		struct hx711_acq_group *group = &acq_groups[g];
+
+		for (uint8_t i = 0; i < group->array.num_sensors; i++) {
+			uint8_t sensor = group->index[i];
+			struct hx711_acq_health *health = &acq_health[sensor];
+			int32_t values[CONFIG_HX711_ARRAY_MAX_SENSORS];
+			uint32_t mask = BIT(i);
+
+			if (!(acq_quarantined & BIT(sensor)) ||
+			    !sys_timepoint_expired(health->probe_at)) {
+				continue;
+			}
+			health->probe_at = sys_timepoint_calc(K_MSEC(CONFIG_HX711_ACQ_PROBE_MS));
+
+			if ((hx711_array_ready_mask(&group->array) & mask) != 0 &&
+			    hx711_array_read_raw(&group->array, &mask, values) == 0) {
+				/* A conversion discarded while settling after a power
+				 * cycle is a sign of life, not a failed probe
+				 */
+				if (mask == 0) {
+					continue;
+				}
+				if (!(health->stuck && hx711_acq_dead_code(values[i]))) {
+					hx711_acq_restore(sensor, values[i]);
+					continue;
+				}
+			}
+
+			if (++health->probes >= CONFIG_HX711_ACQ_PROBE_RESET) {
+				health->probes = 0;
+				(void)hx711_sleep(acq_sensors[sensor]);
+				(void)hx711_wake_up(acq_sensors[sensor]);
+			}
+		}
+	}
+}
+#endif /* CONFIG_HX711_ACQ_HEALTH */
+
+/* Members of the group still in the loop */
+static uint32_t hx711_acq_active(const struct hx711_acq_group *group)
+{
+	uint32_t active = 0;
+
+	for (uint8_t i = 0; i < group->array.num_sensors; i++) {
+		if (!(acq_quarantined & BIT(group->index[i]))) {
+			active |= BIT(i);
+		}
+	}
+
+	return active;
+}
+
+static void hx711_acq_timeouts_rearm(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		acq_seen[i] = now;
+	}
+}
+
+/* The groups never wait on one sensor, so a sensor that stays busy counts
+ * one timeout per HX711_ACQ_TIMEOUT_MS instead, and is quarantined after
+ * CONFIG_HX711_ACQ_HEALTH_TIMEOUTS of them in a row
+ */
+static void hx711_acq_timeouts(const uint32_t *ready)
+{
+	uint32_t now = k_uptime_get_32();
+
+	for (uint8_t g = 0; g < acq_num_groups; g++) {
+		for (uint8_t i = 0; i < acq_groups[g].array.num_sensors; i++) {
+			uint8_t sensor = acq_groups[g].index[i];
+			struct hx711_data *hx711 = acq_sensors[sensor]->data;
+
+			if (acq_quarantined & BIT(sensor)) {
+				continue;
+			}
+
+			if (ready[g] & BIT(i)) {
+				acq_seen[sensor] = now;
+#ifdef CONFIG_HX711_ACQ_HEALTH
+				acq_health[sensor].timeouts = 0;
+#endif
+			} else if (now - acq_seen[sensor] >= HX711_ACQ_TIMEOUT_MS) {
+				HX711_STATS_INC(&hx711->stats, timeouts);
+				acq_seen[sensor] = now;
+#ifdef CONFIG_HX711_ACQ_HEALTH
+				if (++acq_health[sensor].timeouts >=
+				    CONFIG_HX711_ACQ_HEALTH_TIMEOUTS) {
+					hx711_acq_quarantine(sensor, false);
+				}
+#endif
+			}
+		}
+	}
+}
+
+static uint32_t hx711_acq_timestamp(const struct device *dev)
+{
+#ifdef CONFIG_HX711_TRIGGER
+	struct hx711_data *hx711 = dev->data;
+
+	/* Time of the data-ready edge rather than of the read */
+	return hx711->drdy_cycles;
+#else
+	ARG_UNUSED(dev);
+	return k_cycle_get_32();
+#endif
+}
+
+/* Unfiltered, the mean is the sensor's own offset or load */
+static void hx711_acq_mean_add(int32_t value)
+{
+	acq_mean.sum += value;
+	if (--acq_mean.left == 0 && atomic_cas(&acq_mean_armed, 1, 0)) {
+		k_sem_give(&acq_mean_done);
+	}
+}
+
+/* One lockstep read of the ready members of a group, returns the sensors
+ * that produced a valid conversion and whether anything was published
+ */
+static uint32_t hx711_acq_read_group(struct hx711_acq_group *group, uint32_t ready,
+				     bool *published)
+{
+	struct hx711_array *array = &group->array;
+	int32_t values[CONFIG_HX711_ARRAY_MAX_SENSORS];
+	uint32_t timestamps[CONFIG_HX711_ARRAY_MAX_SENSORS];
+	uint32_t valid = 0;
+	int ret;
+
+	/* The edge timestamps are overwritten by the next conversion */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		timestamps[i] = hx711_acq_timestamp(array->sensors[i]);
+	}
+
+	ret = hx711_array_read_raw(array, &ready, values);
+
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		uint8_t sensor = group->index[i];
+		struct hx711_sample sample = {
+			.timestamp = timestamps[i],
+			.raw = ret < 0 ? ret : values[i],
+			.sensor_id = hx711_acq_channel(sensor),
+			.status = ret < 0 ? HX711_SAMPLE_ERROR : hx711_acq_status(sensor),
+		};
+		struct hx711_sample full;
+
+		if (!(ready & BIT(i))) {
+			continue;
+		}
+
+		full = sample;
+		if (ret == 0) {
+			valid |= BIT(sensor);
+		}
+		if (hx711_acq_filter(&sample)) {
+			hx711_acq_publish(&sample, false);
+			*published = true;
+		}
+		if (acq_full_rate != 0) {
+			hx711_acq_low_pass(&full);
+			hx711_acq_publish(&full, true);
+			*published = true;
+		}
+#ifdef CONFIG_HX711_ACQ_HEALTH
+		if (ret == 0) {
+			hx711_acq_check_stuck(sensor, values[i]);
+		}
+#endif
+		if (ret == 0 && atomic_get(&acq_mean_armed) && sensor == acq_mean.sensor &&
+		    hx711_acq_channel(sensor) == sensor) {
+			hx711_acq_mean_add(values[i]);
+		}
+	}
+
+#ifdef CONFIG_HX711_ADAPT
+	/* After the loop, a rate switch applies to the next conversions only */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		uint8_t sensor = group->index[i];
+
+		if (ret == 0 && (ready & BIT(i))) {
+#ifdef CONFIG_HX711_FILTER
+			hx711_acq_adapt(sensor, acq_filters[sensor].value);
+#else
+			hx711_acq_adapt(sensor, values[i]);
+#endif
+		}
+	}
+#endif
+
+	return valid;
+}
+
+/* Cycles since the oldest data-ready edge among the ready members */
+static uint32_t hx711_acq_group_age(const struct hx711_acq_group *group, uint32_t ready,
+				    uint32_t now)
+{
+	uint32_t age = 0;
+
+	for (uint8_t i = 0; i < group->array.num_sensors; i++) {
+		if (ready & BIT(i)) {
+			age = MAX(age, now - hx711_acq_timestamp(group->array.sensors[i]));
+		}
+	}
+
+	return age;
+}
+
+/*
+ * Wait for data-ready and service every group that has a conversion, the
+ * group holding the oldest edge first. Each group is clocked out at most
+ * once per pass, so a conversion waits for at most one frame of every
+ * other group before its own. Returns the sensors that produced a valid
+ * conversion.
+ */
+static uint32_t hx711_acq_cycle(void)
+{
+	uint32_t ready[CONFIG_HX711_ACQ_MAX_GROUPS];
+	uint32_t age[CONFIG_HX711_ACQ_MAX_GROUPS];
+	uint8_t order[CONFIG_HX711_ACQ_MAX_GROUPS];
+	uint8_t num_ready = 0;
+	uint32_t valid = 0;
+	bool published = false;
+	uint32_t now;
+
+#ifdef CONFIG_HX711_TRIGGER
+	/* Sleep until a DOUT falling edge signals data ready */
+	k_poll(acq_drdy_events, acq_num_sensors, K_MSEC(50));
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		acq_drdy_events[i].state = K_POLL_STATE_NOT_READY;
+	}
+#endif
+
+	now = k_cycle_get_32();
+	for (uint8_t g = 0; g < acq_num_groups; g++) {
+		struct hx711_acq_group *group = &acq_groups[g];
+		uint8_t n;
+
+		ready[g] = hx711_array_ready_mask(&group->array) & hx711_acq_active(group);
+		if (ready[g] == 0) {
+			continue;
+		}
+
+		/* Insertion by age, oldest first, there are only a few groups */
+		age[g] = hx711_acq_group_age(group, ready[g], now);
+		for (n = num_ready; n > 0 && age[order[n - 1]] < age[g]; n--) {
+			order[n] = order[n - 1];
+		}
+		order[n] = g;
+		num_ready++;
+	}
+
+	hx711_acq_timeouts(ready);
+#ifdef CONFIG_HX711_ACQ_HEALTH
+	if (acq_quarantined != 0) {
+		hx711_acq_probe();
+	}
+#endif
+	if (num_ready == 0) {
+		if (!IS_ENABLED(CONFIG_HX711_TRIGGER)) {
+			k_msleep(1);
+		}
+		return 0;
+	}
+
+	for (uint8_t n = 0; n < num_ready; n++) {
+		valid |= hx711_acq_read_group(&acq_groups[order[n]], ready[order[n]], &published);
+	}
+
+	/* Decimated frames wake nobody */
+	if (published) {
+		for (size_t i = 0; i < acq_num_rings; i++) {
+			hx711_ring_notify(acq_rings[i]);
+		}
+	}
+
+	return valid;
+}
+
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+/* Power up, collect HX711_ACQ_DUTY_SAMPLES conversions per sensor, power down */
+static void hx711_acq_burst(void)
+{
+	uint8_t counts[CONFIG_HX711_ACQ_MAX_SENSORS] = {0};
+	uint32_t pending = BIT_MASK(acq_num_sensors);
+
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		(void)pm_device_runtime_get(acq_sensors[i]);
+	}
+
+	/* The sensors share one settle window, sleep through it rather than
+	 * clocking out conversions that would be discarded
+	 */
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		k_sleep(hx711_settle_remaining(acq_sensors[i]));
+	}
+	/* Powered down sensors were not late */
+	hx711_acq_timeouts_rearm();
+
+	/* A burst that runs into the next period gives up, and that period is
+	 * skipped. Quarantined sensors are only probed, nobody waits for them.
+	 */
+	while ((pending & ~acq_quarantined) != 0 && k_timer_status_get(&acq_duty_timer) == 0) {
+		uint32_t read = hx711_acq_cycle();
+
+		for (uint8_t i = 0; i < acq_num_sensors; i++) {
+			if ((read & BIT(i)) && ++counts[i] >= CONFIG_HX711_ACQ_DUTY_SAMPLES) {
+				pending &= ~BIT(i);
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		(void)pm_device_runtime_put(acq_sensors[i]);
+	}
+}
+#endif
+
+static void hx711_acq_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+#ifdef CONFIG_HX711_TRIGGER
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+		struct hx711_data *hx711 = acq_sensors[i]->data;
+
+		k_poll_event_init(&acq_drdy_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &hx711->drdy_sem);
+	}
+#endif
+	hx711_acq_timeouts_rearm();
+
+	while (1) {
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+		hx711_acq_burst();
+		k_timer_status_sync(&acq_duty_timer);
+#else
+		(void)hx711_acq_cycle();
+#endif
+	}
+}
+
+K_THREAD_DEFINE(hx711_acq_tid, CONFIG_HX711_ACQ_STACK_SIZE, hx711_acq_thread,
+		NULL, NULL, NULL, CONFIG_HX711_ACQ_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+/* SPI sensors clock their own frame, only the DOUT port matters for them */
+static const struct device *hx711_acq_sck_port(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+
+#ifdef CONFIG_HX711_SPI
+	if (cfg->use_spi) {
+		return NULL;
+	}
+#endif
+	return cfg->sck.port;
+}
+
+/* Group with room whose members share the sensor's ports, or a new one */
+static int hx711_acq_group_for(const struct device *dev, const uint8_t *counts)
+{
+	const struct hx711_config *cfg = dev->config;
+
+	for (uint8_t g = 0; g < acq_num_groups; g++) {
+		const struct device *first = acq_sensors[acq_groups[g].index[0]];
+		const struct hx711_config *first_cfg = first->config;
+
+		if (counts[g] < CONFIG_HX711_ARRAY_MAX_SENSORS &&
+		    first_cfg->dout.port == cfg->dout.port &&
+		    hx711_acq_sck_port(first) == hx711_acq_sck_port(dev)) {
+			return g;
+		}
+	}
+
+	if (acq_num_groups == CONFIG_HX711_ACQ_MAX_GROUPS) {
+		return -ENOMEM;
+	}
+
+	return acq_num_groups++;
+}
+
+int hx711_acq_init(const struct device *const *sensors, size_t num_sensors)
+{
+	uint8_t counts[CONFIG_HX711_ACQ_MAX_GROUPS] = {0};
+	int ret;
+
+	if (!sensors || num_sensors == 0 || num_sensors > CONFIG_HX711_ACQ_MAX_SENSORS) {
+		return -EINVAL;
+	}
+
+	if (acq_started) {
+		return -EBUSY;
+	}
+
+	acq_num_groups = 0;
+	for (uint8_t i = 0; i < num_sensors; i++) {
+		int g = hx711_acq_group_for(sensors[i], counts);
+
+		if (g < 0) {
+			return g;
+		}
+
+		acq_sensors[i] = sensors[i];
+		acq_groups[g].index[counts[g]++] = i;
+	}
+
+	/* Checks readiness and the pin constraints of lockstep */
+	for (uint8_t g = 0; g < acq_num_groups; g++) {
+		const struct device *members[CONFIG_HX711_ARRAY_MAX_SENSORS];
+
+		for (uint8_t n = 0; n < counts[g]; n++) {
+			members[n] = acq_sensors[acq_groups[g].index[n]];
+		}
+
+		ret = hx711_array_init(&acq_groups[g].array, members, counts[g]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	acq_num_sensors = num_sensors;
+
+	return 0;
+}
+
+static int hx711_acq_add_ring(struct hx711_ring *ring, bool full_rate)
+{
+	if (!ring) {
+		return -EINVAL;
+	}
+
+	/* Consumers are fixed once samples start flowing */
+	if (acq_started) {
+		return -EBUSY;
+	}
+
+	if (acq_num_rings == ARRAY_SIZE(acq_rings)) {
+		return -ENOMEM;
+	}
+
+	hx711_ring_init(ring);
+	if (full_rate) {
+		acq_full_rate |= BIT(acq_num_rings);
+	}
+	acq_rings[acq_num_rings++] = ring;
+
+	return 0;
+}
+
+int hx711_acq_add_consumer(struct hx711_ring *ring)
+{
+	return hx711_acq_add_ring(ring, false);
+}
+
+int hx711_acq_add_tap(struct hx711_ring *ring)
+{
+	return hx711_acq_add_ring(ring, true);
+}
+
+int hx711_acq_start(void)
+{
+	if (acq_num_sensors == 0) {
+		return -EINVAL;
+	}
+
+	if (acq_started) {
+		return -EALREADY;
+	}
+
+#ifdef CONFIG_HX711_FILTER
+	/* Channel B of a scanning sensor runs the same chain on its own state */
+	for (uint8_t i = 0; i < 2 * acq_num_sensors; i++) {
+		const struct hx711_config *cfg = acq_sensors[i % acq_num_sensors]->config;
+
+		hx711_filter_init(&acq_filters[i], &cfg->filter);
+	}
+#endif
+
+	for (uint8_t i = 0; i < acq_num_sensors; i++) {
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+		/* Idle sensors are suspended, with SCK held high */
+		(void)pm_device_runtime_enable(acq_sensors[i]);
+#else
+		/* Sensors that runtime PM keeps suspended stay up from now on */
+		(void)pm_device_runtime_get(acq_sensors[i]);
+#endif
+	}
+
+#ifdef CONFIG_HX711_ADAPT
+	hx711_acq_adapt_init();
+#endif
+
+	acq_started = true;
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+	/* The first burst starts with the thread, the timer paces the next ones */
+	k_timer_start(&acq_duty_timer, K_MSEC(CONFIG_HX711_ACQ_DUTY_INTERVAL_MS),
+		      K_MSEC(CONFIG_HX711_ACQ_DUTY_INTERVAL_MS));
+#endif
+	k_thread_start(hx711_acq_tid);
+
+	return 0;
+}
+
+int hx711_acq_mean(uint8_t sensor, uint16_t samples, int32_t *mean)
+{
+	int ret = 0;
+
+	if (sensor >= acq_num_sensors || samples == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&acq_mean_lock, K_FOREVER);
+
+	if (!acq_started) {
+		/* Nothing else reads the sensor yet */
+		ret = hx711_calib_mean(acq_sensors[sensor], samples, mean);
+		k_mutex_unlock(&acq_mean_lock);
+		return ret;
+	}
+
+	k_sem_reset(&acq_mean_done);
+	acq_mean.sensor = sensor;
+	acq_mean.left = samples;
+	acq_mean.sum = 0;
+	atomic_set(&acq_mean_armed, 1);
+
+#ifdef CONFIG_HX711_ACQ_DUTY_CYCLE
+	ret = k_sem_take(&acq_mean_done,
+			 K_MSEC((DIV_ROUND_UP(samples, CONFIG_HX711_ACQ_DUTY_SAMPLES) + 1) *
+				CONFIG_HX711_ACQ_DUTY_INTERVAL_MS));
+#else
+	ret = k_sem_take(&acq_mean_done, K_MSEC(samples * HX711_ACQ_MEAN_SAMPLE_MS + 1000));
+#endif
+	/* The thread may have finished just as the wait timed out */
+	if (ret < 0 && atomic_cas(&acq_mean_armed, 1, 0)) {
+		ret = -ETIMEDOUT;
+	} else {
+		*mean = hx711_round_mean(acq_mean.sum, samples);
+		ret = 0;
+	}
+
+	k_mutex_unlock(&acq_mean_lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_HX711_SHELL
+#define HX711_ACQ_CALIB_SAMPLES 16
+
+/* Points captured since the last tare, tared counts in ascending order */
+static struct hx711_calib_point acq_calib_points[CONFIG_HX711_ACQ_MAX_SENSORS]
+					       [CONFIG_HX711_CALIB_MAX_POINTS];
+static uint8_t acq_calib_num_points[CONFIG_HX711_ACQ_MAX_SENSORS];
+
+static int hx711_acq_shell_sensor(const struct shell *sh, const char *arg, uint8_t *sensor)
+{
+	char *end;
+	unsigned long n = strtoul(arg, &end, 0);
+
+	if (*end != '\0' || n >= acq_num_sensors) {
+		shell_error(sh, "No sensor %s", arg);
+		return -EINVAL;
+	}
+
+	*sensor = n;
+	return 0;
+}
+
+static int hx711_acq_shell_mean(const struct shell *sh, uint8_t sensor, int32_t *mean)
+{
+	int ret = hx711_acq_mean(sensor, HX711_ACQ_CALIB_SAMPLES, mean);
+
+	if (ret < 0) {
+		shell_error(sh, "Read failed: %d", ret);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_calib_tare(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_calib calib;
+	uint8_t sensor;
+	int32_t mean;
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	ret = hx711_acq_shell_sensor(sh, argv[1], &sensor);
+	if (ret == 0) {
+		ret = hx711_acq_shell_mean(sh, sensor, &mean);
+	}
+	if (ret < 0) {
+		return ret;
+	}
+
+	hx711_calib_get(acq_sensors[sensor], &calib);
+	calib.offset = mean;
+	hx711_calib_set(acq_sensors[sensor], &calib);
+
+	/* The zero is the first point of a new table */
+	acq_calib_points[sensor][0].counts = 0;
+	acq_calib_points[sensor][0].milli = 0;
+	acq_calib_num_points[sensor] = 1;
+
+	shell_print(sh, "%s: offset %d", acq_sensors[sensor]->name, mean);
+
+	return 0;
+}
+
+static int cmd_hx711_calib_point(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_calib_point points[CONFIG_HX711_CALIB_MAX_POINTS];
+	struct hx711_calib calib;
+	uint8_t sensor;
+	uint8_t num;
+	uint8_t at;
+	int32_t milli;
+	int32_t mean;
+	int32_t counts;
+	char *end;
+	long load;
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	ret = hx711_acq_shell_sensor(sh, argv[1], &sensor);
+	if (ret < 0) {
+		return ret;
+	}
+
+	load = strtol(argv[2], &end, 0);
+	if (end == argv[2] || *end != '\0' || load < INT32_MIN || load > INT32_MAX) {
+		shell_error(sh, "Bad load %s", argv[2]);
+		return -EINVAL;
+	}
+	milli = load;
+
+	num = acq_calib_num_points[sensor];
+	if (num == 0) {
+		shell_error(sh, "Tare sensor %u first", sensor);
+		return -EINVAL;
+	}
+	if (num >= CONFIG_HX711_CALIB_MAX_POINTS) {
+		shell_error(sh, "Table full, tare to start over");
+		return -ENOSPC;
+	}
+
+	ret = hx711_acq_shell_mean(sh, sensor, &mean);
+	if (ret < 0) {
+		return ret;
+	}
+
+	hx711_calib_get(acq_sensors[sensor], &calib);
+	counts = mean - calib.offset;
+
+	/* Insert in counts order */
+	memcpy(points, acq_calib_points[sensor], num * sizeof(points[0]));
+	for (at = num; at > 0 && points[at - 1].counts > counts; at--) {
+		points[at] = points[at - 1];
+	}
+	points[at].counts = counts;
+	points[at].milli = milli;
+	num++;
+
+	/* Two points make a plain scale, more a piecewise-linear table */
+	if (num == 2) {
+		ret = hx711_calib_set_two_point(&calib, calib.offset + points[0].counts,
+						points[0].milli, calib.offset + points[1].counts,
+						points[1].milli);
+	} else {
+		ret = hx711_calib_set_points(&calib, points, num);
+	}
+	if (ret < 0) {
+		shell_error(sh, "Point rejected: %d", ret);
+		return ret;
+	}
+
+	hx711_calib_set(acq_sensors[sensor], &calib);
+	memcpy(acq_calib_points[sensor], points, num * sizeof(points[0]));
+	acq_calib_num_points[sensor] = num;
+
+	shell_print(sh, "%s: %d counts = %d, %u points", acq_sensors[sensor]->name, counts, milli,
+		    num);
+
+	return 0;
+}
+
+static int cmd_hx711_calib_save(const struct shell *sh, size_t argc, char **argv)
+{
+	uint8_t sensor;
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	ret = hx711_acq_shell_sensor(sh, argv[1], &sensor);
+	if (ret < 0) {
+		return ret;
+	}
+
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+	ret = hx711_calib_save(acq_sensors[sensor]);
+	if (ret < 0) {
+		shell_error(sh, "Save failed: %d", ret);
+	}
+#else
+	shell_error(sh, "Built without CONFIG_HX711_CALIB_SETTINGS");
+	ret = -ENOTSUP;
+#endif
+
+	return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_hx711_calib,
+	SHELL_CMD_ARG(tare, NULL, "<sensor>, the current load becomes zero",
+		      cmd_hx711_calib_tare, 2, 0),
+	SHELL_CMD_ARG(point, NULL, "<sensor> <milli>, the current load is milli milli-units",
+		      cmd_hx711_calib_point, 3, 0),
+	SHELL_CMD_ARG(save, NULL, "<sensor>, persist the calibration", cmd_hx711_calib_save,
+		      2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((hx711), calib, &sub_hx711_calib,
+		 "Calibrate a sensor: tare, a point per known load, then save", NULL, 1, 0);
+#endif /* CONFIG_HX711_SHELL */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_ACQ_H_
+#define HX711_ACQ_H_
+
+#include "hx711_driver.h"
+#include "hx711_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The acquisition thread owns up to CONFIG_HX711_ACQ_MAX_SENSORS sensors.
+ * Sensors that share an SCK port and a DOUT port form a group that is
+ * clocked out in lockstep, so one frame reads every ready member and the
+ * cost of a pass grows with the number of groups, not of sensors. Every
+ * pass services each group with a ready member once, the group holding
+ * the oldest data-ready edge first.
+ *
+ * Sample channels: sensor n is channel n. A sensor in A/B scan mode also
+ * reports its channel B conversions as channel N + n, N being the number
+ * of sensors.
+ */
+#define HX711_ACQ_MAX_CHANNELS (2 * CONFIG_HX711_ACQ_MAX_SENSORS)
+
+/* Group the sensors by port, sensors[n] becomes sensor n */
+int hx711_acq_init(const struct device *const *sensors, size_t num_sensors);
+
+/* N, or 2N when any sensor scans channel B */
+size_t hx711_acq_num_channels(void);
+
+/* Calibrated load of a channel in milli-units, channel B stays in counts */
+int32_t hx711_acq_load(uint8_t channel, int32_t counts);
+
+/*
+ * Rounded mean of sensor's next samples channel A conversions, summed by
+ * the acquisition thread so nothing else clocks the sensor. Before
+ * hx711_acq_start() the sensor is read directly. -ETIMEDOUT when the
+ * sensor stops converting, e.g. while quarantined.
+ */
+int hx711_acq_mean(uint8_t sensor, uint16_t samples, int32_t *mean);
+
+/* Bit n set while sensor n is quarantined, see CONFIG_HX711_ACQ_HEALTH */
+uint32_t hx711_acq_quarantined(void);
+
+/* Register a consumer ring, every sample is pushed to every ring */
+int hx711_acq_add_consumer(struct hx711_ring *ring);
+
+/* Register a ring that takes every conversion at the full rate, after the
+ * spike and low-pass stages of the filter chain but before decimation
+ */
+int hx711_acq_add_tap(struct hx711_ring *ring);
+
+/* Start the acquisition thread on the sensors given to hx711_acq_init() */
+int hx711_acq_start(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_ACQ_H_ */
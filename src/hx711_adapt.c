@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_adapt.h"
+#include <zephyr/sys/util.h>
+#include <stdlib.h>
+
+BUILD_ASSERT(CONFIG_HX711_ADAPT_WAKE_DELTA > 2 * CONFIG_HX711_ADAPT_IDLE_NOISE,
+	     "CONFIG_HX711_ADAPT_WAKE_DELTA must clear the idle noise with margin");
+
+#define HX711_ADAPT_IDLE_VAR ((int64_t)CONFIG_HX711_ADAPT_IDLE_NOISE * \
+			      CONFIG_HX711_ADAPT_IDLE_NOISE)
+
+void hx711_adapt_reset(struct hx711_adapt *adapt)
+{
+	adapt->primed = false;
+	adapt->mean_acc = 0;
+	adapt->var = 0;
+	adapt->idle = false;
+}
+
+void hx711_adapt_set_idle(struct hx711_adapt *adapt, bool idle)
+{
+	adapt->idle = idle;
+	adapt->baseline = adapt->mean_acc >> CONFIG_HX711_ADAPT_SHIFT;
+}
+
+enum hx711_adapt_level hx711_adapt_update(struct hx711_adapt *adapt, int32_t value)
+{
+	int64_t dev;
+
+	/* The first conversion is the mean, nothing is known about the noise */
+	if (!adapt->primed) {
+		adapt->primed = true;
+		adapt->mean_acc = (int64_t)value << CONFIG_HX711_ADAPT_SHIFT;
+		adapt->var = HX711_ADAPT_IDLE_VAR;
+		return HX711_ADAPT_BUSY;
+	}
+
+	dev = value - (adapt->mean_acc >> CONFIG_HX711_ADAPT_SHIFT);
+	adapt->mean_acc += dev;
+	adapt->var += (dev * dev - adapt->var) >> CONFIG_HX711_ADAPT_SHIFT;
+
+	if (llabs(dev) > CONFIG_HX711_ADAPT_WAKE_DELTA ||
+	    (adapt->idle && llabs((int64_t)value - adapt->baseline) > CONFIG_HX711_ADAPT_WAKE_DELTA)) {
+		return HX711_ADAPT_CHANGE;
+	}
+
+	return adapt->var < HX711_ADAPT_IDLE_VAR ? HX711_ADAPT_QUIET : HX711_ADAPT_BUSY;
+}
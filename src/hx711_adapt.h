@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_ADAPT_H_
+#define HX711_ADAPT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Activity detector for the adaptive sampling rate. Every filtered
+ * conversion updates an exponentially weighted mean and variance, the
+ * weight of a new conversion being 1 / 2^CONFIG_HX711_ADAPT_SHIFT. A
+ * sensor is quiet while the standard deviation stays below
+ * CONFIG_HX711_ADAPT_IDLE_NOISE, and a single conversion further than
+ * CONFIG_HX711_ADAPT_WAKE_DELTA from the mean is a change. The band in
+ * between is the hysteresis: it neither enters nor leaves the idle rate.
+ *
+ * The low-pass stages turn a step into a ramp the running mean follows,
+ * so while idle a conversion that far from the mean held at the switch
+ * is a change as well.
+ */
+
+/* Ratio of the active to the idle rate, 80 to 10 SPS */
+#define HX711_ADAPT_RATIO 8
+
+enum hx711_adapt_level {
+	HX711_ADAPT_QUIET,
+	HX711_ADAPT_BUSY,
+	HX711_ADAPT_CHANGE,
+};
+
+struct hx711_adapt {
+	bool primed;
+	int64_t mean_acc;      /* Mean scaled by 2^shift */
+	int64_t var;           /* Counts squared */
+	bool idle;
+	int32_t baseline;      /* Mean when the idle rate was entered */
+};
+
+void hx711_adapt_reset(struct hx711_adapt *adapt);
+
+/* Entering the idle rate holds the current mean as the baseline */
+void hx711_adapt_set_idle(struct hx711_adapt *adapt, bool idle);
+
+enum hx711_adapt_level hx711_adapt_update(struct hx711_adapt *adapt, int32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_ADAPT_H_ */
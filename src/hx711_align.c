@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_align.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+BUILD_ASSERT(CONFIG_HX711_ALIGN_TIMEOUT_MS * CONFIG_HX711_ALIGN_RATE_HZ >= MSEC_PER_SEC,
+	     "CONFIG_HX711_ALIGN_TIMEOUT_MS must span at least one grid period");
+
+/* Cycle counts wrap, compare them through the signed difference */
+static inline int32_t hx711_align_diff(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b);
+}
+
+int hx711_align_init(struct hx711_align *align, uint8_t num_channels, hx711_align_cb_t cb,
+		     void *user_data)
+{
+	uint32_t hz = sys_clock_hw_cycles_per_sec();
+
+	if (num_channels == 0 || num_channels > HX711_ALIGN_MAX_CHANNELS || cb == NULL) {
+		return -EINVAL;
+	}
+
+	memset(align, 0, sizeof(*align));
+	align->num_channels = num_channels;
+	align->period = hz / CONFIG_HX711_ALIGN_RATE_HZ;
+	align->timeout = (uint32_t)(((uint64_t)hz * CONFIG_HX711_ALIGN_TIMEOUT_MS) / MSEC_PER_SEC);
+	align->stride = align->period;
+	align->span = align->timeout;
+	align->cb = cb;
+	align->user_data = user_data;
+
+	return 0;
+}
+
+/*
+ * Value of one channel at time t. Returns the cycles to the nearest
+ * conversion used and sets *interpolated when t lies between two
+ * conversions no further apart than the timeout, or on one of them.
+ * UINT32_MAX when the channel has no conversion yet.
+ */
+static uint32_t hx711_align_sample(const struct hx711_align *align,
+				   const struct hx711_align_channel *ch, uint32_t t,
+				   int32_t *value, bool *interpolated)
+{
+	int before = -1;
+	int after = -1;
+	uint32_t age;
+
+	*interpolated = false;
+	if (ch->count == 0) {
+		*value = 0;
+		return UINT32_MAX;
+	}
+
+	/* Newest first, the history is in arrival order which is time order */
+	for (uint8_t n = 0; n < ch->count; n++) {
+		int i = (ch->head + HX711_ALIGN_HISTORY - 1 - n) % HX711_ALIGN_HISTORY;
+
+		if (hx711_align_diff(ch->hist[i].timestamp, t) >= 0) {
+			after = i;
+		} else {
+			before = i;
+			break;
+		}
+	}
+
+	if (after >= 0 && ch->hist[after].timestamp == t) {
+		*value = ch->hist[after].value;
+		*interpolated = true;
+		return 0;
+	}
+
+	if (before >= 0 && after >= 0) {
+		uint32_t span = ch->hist[after].timestamp - ch->hist[before].timestamp;
+		uint32_t into = t - ch->hist[before].timestamp;
+
+		if (span <= align->span) {
+			int64_t delta = (int64_t)ch->hist[after].value - ch->hist[before].value;
+
+			*value = ch->hist[before].value + (int32_t)((delta * into) / span);
+			*interpolated = true;
+			return MIN(into, span - into);
+		}
+	}
+
+	/* Hold the nearest conversion */
+	if (after < 0 || (before >= 0 && t - ch->hist[before].timestamp <
+					 ch->hist[after].timestamp - t)) {
+		*value = ch->hist[before].value;
+		age = t - ch->hist[before].timestamp;
+	} else {
+		*value = ch->hist[after].value;
+		age = ch->hist[after].timestamp - t;
+	}
+
+	return age;
+}
+
+/* True when every channel has a conversion at or after t */
+static bool hx711_align_complete(const struct hx711_align *align, uint32_t t)
+{
+	for (uint8_t c = 0; c < align->num_channels; c++) {
+		const struct hx711_align_channel *ch = &align->channels[c];
+		uint8_t newest = (ch->head + HX711_ALIGN_HISTORY - 1) % HX711_ALIGN_HISTORY;
+
+		if (ch->count == 0 || hx711_align_diff(ch->hist[newest].timestamp, t) < 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Earliest conversion after t on any channel, t itself when there is none */
+static uint32_t hx711_align_next_after(const struct hx711_align *align, uint32_t t)
+{
+	uint32_t next = t;
+	bool found = false;
+
+	for (uint8_t c = 0; c < align->num_channels; c++) {
+		const struct hx711_align_channel *ch = &align->channels[c];
+
+		for (uint8_t n = 0; n < ch->count; n++) {
+			uint8_t i = (ch->head + HX711_ALIGN_HISTORY - ch->count + n) %
+				    HX711_ALIGN_HISTORY;
+			uint32_t ts = ch->hist[i].timestamp;
+
+			if (hx711_align_diff(ts, t) > 0) {
+				if (!found || hx711_align_diff(ts, next) < 0) {
+					next = ts;
+					found = true;
+				}
+				break;
+			}
+		}
+	}
+
+	return next;
+}
+
+static void hx711_align_emit(struct hx711_align *align)
+{
+	struct hx711_align_frame *frame = &align->frame;
+
+	while (hx711_align_complete(align, align->grid) ||
+	       hx711_align_diff(align->latest, align->grid) > (int32_t)align->span) {
+		bool near = false;
+
+		frame->timestamp = align->grid;
+		frame->stale = 0;
+
+		for (uint8_t c = 0; c < align->num_channels; c++) {
+			bool interpolated;
+
+			frame->age[c] = hx711_align_sample(align, &align->channels[c], align->grid,
+							   &frame->values[c], &interpolated);
+			if (!interpolated) {
+				frame->stale |= BIT(c);
+			}
+			if (frame->age[c] <= align->span) {
+				near = true;
+			}
+		}
+
+		/* A gap with no conversions at all, e.g. sensors powered down
+		 * between bursts, is skipped rather than filled with stale frames
+		 */
+		if (!near) {
+			uint32_t next = hx711_align_next_after(align, align->grid);
+			uint32_t steps = (next - align->grid) / align->stride;
+
+			align->grid += MAX(steps, 1) * align->stride;
+			continue;
+		}
+
+		align->cb(frame, align->user_data);
+		align->last = align->grid;
+		align->emitted = true;
+		align->grid += align->stride;
+	}
+}
+
+/* Widen the grid while every channel is idle, narrow it on the first active sample */
+static void hx711_align_track_idle(struct hx711_align *align, const struct hx711_sample *sample)
+{
+	uint32_t all = align->num_channels == 32 ? UINT32_MAX : BIT_MASK(align->num_channels);
+	bool was_idle = align->idle == all;
+
+	WRITE_BIT(align->idle, sample->sensor_id, sample->status & HX711_SAMPLE_IDLE);
+	if ((align->idle == all) == was_idle) {
+		return;
+	}
+
+	if (!was_idle) {
+		align->stride = align->period * HX711_ADAPT_RATIO;
+		align->span = align->timeout * HX711_ADAPT_RATIO;
+		return;
+	}
+
+	align->stride = align->period;
+	align->span = align->timeout;
+
+	/* The wide stride skipped grid points the active samples now cover */
+	if (align->emitted && hx711_align_diff(align->grid, align->last + align->period) > 0) {
+		align->grid = align->last + align->period;
+	}
+}
+
+void hx711_align_put(struct hx711_align *align, const struct hx711_sample *sample)
+{
+	struct hx711_align_channel *ch;
+
+	if ((sample->status & HX711_SAMPLE_ERROR) || sample->sensor_id >= align->num_channels) {
+		return;
+	}
+
+	hx711_align_track_idle(align, sample);
+
+	ch = &align->channels[sample->sensor_id];
+	ch->hist[ch->head].timestamp = sample->timestamp;
+	ch->hist[ch->head].value = sample->raw;
+	ch->head = (ch->head + 1) % HX711_ALIGN_HISTORY;
+	if (ch->count < HX711_ALIGN_HISTORY) {
+		ch->count++;
+	}
+
+	if (!align->started) {
+		align->started = true;
+		align->grid = sample->timestamp;
+		align->latest = sample->timestamp;
+	} else if (hx711_align_diff(sample->timestamp, align->latest) > 0) {
+		align->latest = sample->timestamp;
+	}
+
+	hx711_align_emit(align);
+}
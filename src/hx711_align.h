@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_ALIGN_H_
+#define HX711_ALIGN_H_
+
+#include "hx711_acq.h"
+#include "hx711_adapt.h"
+#include "hx711_ring.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Every HX711 converts on its own oscillator, so the channels drift
+ * against each other. The alignment stage resamples them onto one
+ * fixed-rate grid of cycle-count timestamps: a grid point is emitted
+ * once every channel has a conversion at or after it, each channel
+ * linearly interpolated between the two conversions around it. A channel
+ * that has nothing after the grid point within CONFIG_HX711_ALIGN_TIMEOUT_MS
+ * holds its nearest value and is flagged stale, so one dead sensor does
+ * not stall the others.
+ *
+ * While every channel delivers HX711_SAMPLE_IDLE samples the grid period
+ * and the timeout grow by HX711_ADAPT_RATIO, so an idle system emits as
+ * many fewer frames as it converts. The first active sample brings the
+ * grid back to the full rate from the last frame emitted.
+ */
+
+/* Stale flags are one uint32_t */
+#define HX711_ALIGN_MAX_CHANNELS MIN(HX711_ACQ_MAX_CHANNELS, 32)
+
+/* Conversions kept per channel: a grid point that waited the whole
+ * timeout still finds the conversion before it at 80 SPS
+ */
+#define HX711_ALIGN_HISTORY (CONFIG_HX711_ALIGN_TIMEOUT_MS * 80 / MSEC_PER_SEC + 4)
+
+struct hx711_align_frame {
+	uint32_t timestamp;   /* Grid point, cycle count */
+	uint32_t stale;       /* Bit n set when channel n was held, not interpolated */
+	int32_t values[HX711_ALIGN_MAX_CHANNELS];
+	/* Cycles from the grid point to the nearest conversion used */
+	uint32_t age[HX711_ALIGN_MAX_CHANNELS];
+};
+
+typedef void (*hx711_align_cb_t)(const struct hx711_align_frame *frame, void *user_data);
+
+struct hx711_align_channel {
+	struct {
+		uint32_t timestamp;
+		int32_t value;
+	} hist[HX711_ALIGN_HISTORY];
+	uint8_t head;          /* Next slot to write */
+	uint8_t count;
+};
+
+struct hx711_align {
+	struct hx711_align_channel channels[HX711_ALIGN_MAX_CHANNELS];
+	uint8_t num_channels;
+	bool started;
+	uint32_t grid;         /* Next grid point to emit */
+	uint32_t latest;       /* Newest conversion on any channel */
+	uint32_t period;       /* Grid period in cycles */
+	uint32_t timeout;      /* In cycles */
+	uint32_t idle;         /* Channels whose newest sample is an idle one */
+	uint32_t stride;       /* Current grid step, period or the idle one */
+	uint32_t span;         /* Current timeout, scaled like the stride */
+	uint32_t last;         /* Grid point of the last frame emitted */
+	bool emitted;
+	hx711_align_cb_t cb;
+	void *user_data;
+	struct hx711_align_frame frame;
+};
+
+/* Grid at CONFIG_HX711_ALIGN_RATE_HZ, cb runs from hx711_align_put() */
+int hx711_align_init(struct hx711_align *align, uint8_t num_channels, hx711_align_cb_t cb,
+		     void *user_data);
+
+/* Feed one published sample, errors and unknown channels are ignored */
+void hx711_align_put(struct hx711_align *align, const struct hx711_sample *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_ALIGN_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_driver.h"
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/printk.h>
+
+/* Submissions are parked until the DOUT falling edge, then completed from
+ * the system workqueue. A streaming submission is multishot, so RTIO hands
+ * it back through hx711_submit() as soon as it completes and every
+ * conversion lands in the completion queue without a blocking call.
+ */
+
+static int hx711_check_channels(const struct sensor_read_config *cfg)
+{
+	for (size_t i = 0; i < cfg->count; i++) {
+		switch ((int)cfg->channels[i].chan_type) {
+		case SENSOR_CHAN_ALL:
+		case SENSOR_CHAN_HX711_RAW:
+		case SENSOR_CHAN_HX711_LOAD:
+			break;
+		default:
+			return -ENOTSUP;
+		}
+	}
+
+	return 0;
+}
+
+/* Only data-ready is supported, returns the data option to apply */
+static int hx711_check_triggers(const struct sensor_read_config *cfg)
+{
+	enum sensor_stream_data_opt opt = SENSOR_STREAM_DATA_INCLUDE;
+	bool drdy = false;
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		if (cfg->triggers[i].trigger != SENSOR_TRIG_DATA_READY) {
+			return -ENOTSUP;
+		}
+		drdy = true;
+		opt = cfg->triggers[i].opt;
+	}
+
+	return drdy ? (int)opt : -EINVAL;
+}
+
+void hx711_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	const struct hx711_config *hx711_cfg = dev->config;
+	struct hx711_data *data = dev->data;
+	int ret;
+
+	ret = cfg->is_streaming ? hx711_check_triggers(cfg) : hx711_check_channels(cfg);
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	/* One outstanding submission per sensor */
+	if (!atomic_ptr_cas(&data->rtio_sqe, NULL, iodev_sqe)) {
+		rtio_iodev_sqe_err(iodev_sqe, -EBUSY);
+		return;
+	}
+
+	/* The edge may have come before the submission, DOUT stays low until read */
+	if (gpio_pin_get_dt(&hx711_cfg->dout) == 0) {
+		k_work_submit(&data->rtio_work);
+	}
+}
+
+void hx711_async_drdy(struct hx711_data *data)
+{
+	if (atomic_ptr_get(&data->rtio_sqe) != NULL) {
+		k_work_submit(&data->rtio_work);
+	}
+}
+
+static void hx711_async_work(struct k_work *work)
+{
+	struct hx711_data *data = CONTAINER_OF(work, struct hx711_data, rtio_work);
+	const struct device *dev = data->dev;
+	struct rtio_iodev_sqe *iodev_sqe = atomic_ptr_clear(&data->rtio_sqe);
+	const struct sensor_read_config *read_cfg;
+	struct hx711_encoded_data *edata;
+	uint8_t *buf;
+	uint32_t buf_len;
+	uint64_t timestamp_ns;
+	int32_t raw;
+	int ret;
+
+	if (iodev_sqe == NULL) {
+		return;
+	}
+
+	/* Date the data-ready edge, not the moment the workqueue got here */
+	timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks()) -
+		       k_cyc_to_ns_floor64(k_cycle_get_32() - data->drdy_cycles);
+
+	/* The conversion is clocked out even when dropped so DOUT rearms */
+	ret = hx711_read_raw(dev, &raw);
+	if (ret == -EAGAIN) {
+		/* Settling after a channel switch, wait for the next conversion */
+		atomic_ptr_set(&data->rtio_sqe, iodev_sqe);
+		return;
+	}
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, sizeof(*edata), sizeof(*edata), &buf, &buf_len);
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	read_cfg = iodev_sqe->sqe.iodev->data;
+	edata = (struct hx711_encoded_data *)buf;
+	edata->timestamp_ns = timestamp_ns;
+	edata->raw = raw;
+	edata->load_milli = hx711_load(dev, raw, data->last_gain);
+	edata->drdy = read_cfg->is_streaming;
+	edata->has_sample = !read_cfg->is_streaming ||
+			    hx711_check_triggers(read_cfg) == SENSOR_STREAM_DATA_INCLUDE;
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+void hx711_async_init(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+
+	k_work_init(&data->rtio_work, hx711_async_work);
+	atomic_ptr_set(&data->rtio_sqe, NULL);
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_block.h"
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <string.h>
+
+static inline uint32_t hx711_zigzag(int32_t v)
+{
+	return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t hx711_unzigzag(uint32_t v)
+{
+	return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static size_t hx711_varint_put(uint8_t *out, uint32_t v)
+{
+	size_t len = 0;
+
+	while (v >= 0x80) {
+		out[len++] = (uint8_t)v | 0x80;
+		v >>= 7;
+	}
+	out[len++] = (uint8_t)v;
+
+	return len;
+}
+
+static int hx711_varint_get(struct hx711_block_reader *reader, uint32_t *v)
+{
+	uint32_t value = 0;
+
+	for (uint8_t shift = 0; shift < 35; shift += 7) {
+		uint8_t byte;
+
+		if (reader->pos >= reader->hdr.length) {
+			return -EBADMSG;
+		}
+
+		byte = reader->buf[reader->pos++];
+		value |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			*v = value;
+			return 0;
+		}
+	}
+
+	return -EBADMSG;
+}
+
+void hx711_block_start(struct hx711_block *block, uint8_t *buf, size_t size,
+		       const struct hx711_block_header *hdr, uint32_t period_cycles)
+{
+	block->hdr = *hdr;
+	block->hdr.version = HX711_BLOCK_VERSION;
+	block->hdr.frames = 0;
+	block->buf = buf;
+	block->size = MIN(size, UINT16_MAX);
+	block->len = HX711_BLOCK_HEADER_SIZE;
+	block->period = period_cycles;
+	memset(block->last, 0, sizeof(block->last));
+}
+
+bool hx711_block_add(struct hx711_block *block, const struct hx711_align_frame *frame)
+{
+	uint8_t record[HX711_BLOCK_MAX_FRAME(HX711_ALIGN_MAX_CHANNELS)];
+	uint32_t periods = 0;
+	bool packed = true;
+	size_t len;
+
+	if (block->hdr.frames == UINT16_MAX) {
+		return false;
+	}
+
+	/* Grid points are whole periods apart, gaps were skipped by the aligner */
+	if (block->hdr.frames > 0) {
+		periods = (frame->timestamp - block->last_time + block->period / 2) / block->period;
+	}
+
+	for (uint8_t i = 0; i < block->hdr.channels && packed; i++) {
+		packed = hx711_zigzag(frame->values[i] - block->last[i]) < 16;
+	}
+
+	/* The periods can only overflow the tag after a gap of years */
+	len = hx711_varint_put(record, (MIN(periods, UINT32_MAX >> 2) << 2) | (packed << 1) |
+				       (frame->stale != 0));
+	if (frame->stale != 0) {
+		len += hx711_varint_put(&record[len], frame->stale);
+	}
+
+	for (uint8_t i = 0; i < block->hdr.channels; i++) {
+		uint32_t delta = hx711_zigzag(frame->values[i] - block->last[i]);
+
+		if (!packed) {
+			len += hx711_varint_put(&record[len], delta);
+		} else if (i & 1) {
+			record[len++] |= delta << 4;
+		} else {
+			record[len] = delta;
+		}
+	}
+	if (packed && (block->hdr.channels & 1)) {
+		len++;
+	}
+
+	if (block->len + len > block->size) {
+		return false;
+	}
+
+	memcpy(&block->buf[block->len], record, len);
+	block->len += len;
+	block->hdr.frames++;
+	block->last_time = frame->timestamp;
+	memcpy(block->last, frame->values, block->hdr.channels * sizeof(block->last[0]));
+
+	return true;
+}
+
+size_t hx711_block_finish(struct hx711_block *block)
+{
+	uint8_t *out = block->buf;
+
+	block->hdr.length = block->len;
+
+	out[0] = block->hdr.version;
+	out[1] = block->hdr.channels;
+	sys_put_le16(block->hdr.frames, &out[2]);
+	sys_put_le16(block->hdr.boot, &out[4]);
+	sys_put_le16(block->hdr.length, &out[6]);
+	sys_put_le32(block->hdr.seq, &out[8]);
+	sys_put_le32(block->hdr.period_us, &out[12]);
+	sys_put_le64(block->hdr.time_ms, &out[16]);
+
+	return block->len;
+}
+
+int hx711_block_parse_header(const uint8_t *buf, size_t len, struct hx711_block_header *hdr)
+{
+	if (len < HX711_BLOCK_HEADER_SIZE) {
+		return -EBADMSG;
+	}
+
+	hdr->version = buf[0];
+	hdr->channels = buf[1];
+	hdr->frames = sys_get_le16(&buf[2]);
+	hdr->boot = sys_get_le16(&buf[4]);
+	hdr->length = sys_get_le16(&buf[6]);
+	hdr->seq = sys_get_le32(&buf[8]);
+	hdr->period_us = sys_get_le32(&buf[12]);
+	hdr->time_ms = sys_get_le64(&buf[16]);
+
+	if (hdr->version != HX711_BLOCK_VERSION || hdr->channels == 0 ||
+	    hdr->channels > HX711_ALIGN_MAX_CHANNELS || hdr->length < HX711_BLOCK_HEADER_SIZE ||
+	    hdr->length > len) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+int hx711_block_reader_init(struct hx711_block_reader *reader, const uint8_t *buf, size_t len)
+{
+	int ret;
+
+	ret = hx711_block_parse_header(buf, len, &reader->hdr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	reader->buf = buf;
+	reader->pos = HX711_BLOCK_HEADER_SIZE;
+	reader->left = reader->hdr.frames;
+	reader->periods = 0;
+	memset(reader->values, 0, sizeof(reader->values));
+
+	return 0;
+}
+
+int hx711_block_next(struct hx711_block_reader *reader, uint64_t *time_us, uint32_t *stale,
+		     int32_t *values)
+{
+	uint32_t tag, delta;
+	int ret;
+
+	if (reader->left == 0) {
+		return -ENODATA;
+	}
+
+	ret = hx711_varint_get(reader, &tag);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*stale = 0;
+	if (tag & 1) {
+		ret = hx711_varint_get(reader, stale);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	for (uint8_t i = 0; i < reader->hdr.channels; i++) {
+		if (!(tag & 2)) {
+			ret = hx711_varint_get(reader, &delta);
+			if (ret < 0) {
+				return ret;
+			}
+		} else if (reader->pos >= reader->hdr.length) {
+			return -EBADMSG;
+		} else {
+			delta = (reader->buf[reader->pos] >> (4 * (i & 1))) & 0x0F;
+			if ((i & 1) || i == reader->hdr.channels - 1) {
+				reader->pos++;
+			}
+		}
+
+		reader->values[i] += hx711_unzigzag(delta);
+		values[i] = reader->values[i];
+	}
+
+	reader->periods += tag >> 2;
+	reader->left--;
+	*time_us = reader->hdr.time_ms * 1000 + reader->periods * reader->hdr.period_us;
+
+	return 0;
+}
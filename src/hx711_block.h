@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_BLOCK_H_
+#define HX711_BLOCK_H_
+
+#include "hx711_align.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compressed block of aligned frames, little endian:
+ *
+ *   u8  version (HX711_BLOCK_VERSION)
+ *   u8  channel count N
+ *   u16 frame count
+ *   u16 boot number
+ *   u16 block length, header included
+ *   u32 sequence number, counts up across boots
+ *   u32 grid period in microseconds
+ *   u64 uptime of the first frame in milliseconds
+ *
+ * followed by one record per frame:
+ *
+ *   tag            varint, grid periods since the previous frame << 2 |
+ *                  packed << 1 | stale present
+ *   stale mask     varint, only when the tag says so
+ *   N x delta      zig-zag coded difference to the channel's previous value,
+ *                  a varint each, or two per byte, low nibble first, when
+ *                  every delta of the frame fits in a nibble
+ *
+ * Varints are unsigned LEB128. The first frame of a block has 0 periods
+ * and deltas against 0, so a block decodes on its own. Slowly varying load
+ * data packs most frames, two channels per byte plus the tag.
+ */
+#define HX711_BLOCK_VERSION     1
+#define HX711_BLOCK_HEADER_SIZE 24
+
+/* Tag, stale mask and up to five bytes per delta */
+#define HX711_BLOCK_MAX_FRAME(channels) (10 + 5 * (channels))
+
+struct hx711_block_header {
+	uint8_t version;
+	uint8_t channels;
+	uint16_t frames;
+	uint16_t boot;
+	uint16_t length;
+	uint32_t seq;
+	uint32_t period_us;
+	uint64_t time_ms;
+};
+
+/* Encoder state, buf holds at most size bytes */
+struct hx711_block {
+	struct hx711_block_header hdr;
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+	uint32_t period;       /* Grid period in cycles */
+	uint32_t last_time;    /* Grid point of the previous frame */
+	int32_t last[HX711_ALIGN_MAX_CHANNELS];
+};
+
+/* Decoder state over one block */
+struct hx711_block_reader {
+	struct hx711_block_header hdr;
+	const uint8_t *buf;
+	size_t pos;
+	uint16_t left;         /* Frames not read yet */
+	uint64_t periods;      /* Grid periods since the first frame */
+	int32_t values[HX711_ALIGN_MAX_CHANNELS];
+};
+
+/* hdr.version, hdr.channels and the payload are filled in by the encoder */
+void hx711_block_start(struct hx711_block *block, uint8_t *buf, size_t size,
+		       const struct hx711_block_header *hdr, uint32_t period_cycles);
+
+/* Returns false and leaves the block as is when the frame does not fit */
+bool hx711_block_add(struct hx711_block *block, const struct hx711_align_frame *frame);
+
+/* Writes the header, returns the length of the finished block */
+size_t hx711_block_finish(struct hx711_block *block);
+
+int hx711_block_parse_header(const uint8_t *buf, size_t len, struct hx711_block_header *hdr);
+
+int hx711_block_reader_init(struct hx711_block_reader *reader, const uint8_t *buf, size_t len);
+
+/* Next frame, values has hdr.channels entries. Returns -ENODATA at the end
+ * and -EBADMSG on a malformed block.
+ */
+int hx711_block_next(struct hx711_block_reader *reader, uint64_t *time_us, uint32_t *stale,
+		     int32_t *values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_BLOCK_H_ */
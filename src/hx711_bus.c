@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_bus.h"
+#include "hx711_acq.h"
+#include "hx711_align.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_HX711_SHELL
+#include <zephyr/shell/shell.h>
+#endif
+
+#define BUS_SAMPLE_BATCH 16
+/* Long enough for a reader to finish copying the message, a subscriber
+ * with a full queue holds the bus thread no longer than this
+ */
+#define BUS_TIMEOUT K_MSEC(2)
+
+ZBUS_CHAN_DEFINE(hx711_frame_chan, struct hx711_bus_frame, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(hx711_batch_chan, struct hx711_bus_batch, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+HX711_RING_DEFINE(bus_ring);
+
+static struct hx711_align bus_align;
+static uint8_t bus_channels;
+static uint32_t bus_idle;
+static uint32_t bus_errors;
+/* Filled here, copied into the channel once full */
+static struct hx711_bus_batch bus_batch;
+static struct hx711_bus_info bus_info;
+
+static void bus_aligned(const struct hx711_align_frame *frame, void *user_data)
+{
+	struct hx711_bus_frame *out = &bus_batch.frames[bus_batch.count];
+
+	ARG_UNUSED(user_data);
+
+	out->seq = bus_info.frames++;
+	out->timestamp = frame->timestamp;
+	out->stale = frame->stale;
+	out->idle = bus_idle;
+	out->errors = bus_errors;
+	out->channels = bus_channels;
+	for (uint8_t i = 0; i < bus_channels; i++) {
+		out->values[i] = IS_ENABLED(CONFIG_HX711_BUS_LOAD) ?
+				 hx711_acq_load(i, frame->values[i]) : frame->values[i];
+	}
+
+	/* Listeners run right here, on this thread */
+	if (zbus_chan_pub(&hx711_frame_chan, out, BUS_TIMEOUT) < 0) {
+		bus_info.undelivered++;
+	}
+
+	if (++bus_batch.count < CONFIG_HX711_BUS_BATCH) {
+		return;
+	}
+
+	if (zbus_chan_pub(&hx711_batch_chan, &bus_batch, BUS_TIMEOUT) < 0) {
+		bus_info.undelivered++;
+	}
+	bus_info.batches++;
+	bus_batch.count = 0;
+}
+
+static void bus_thread(void *p1, void *p2, void *p3)
+{
+	struct hx711_sample batch[BUS_SAMPLE_BATCH];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		size_t count = hx711_ring_get(&bus_ring, batch, ARRAY_SIZE(batch), K_FOREVER);
+
+		for (size_t i = 0; i < count; i++) {
+			uint32_t bit;
+
+			if (batch[i].sensor_id >= bus_channels) {
+				continue;
+			}
+			bit = BIT(batch[i].sensor_id);
+
+			/* The frame carries the status of the newest sample per channel */
+			if (batch[i].status & HX711_SAMPLE_ERROR) {
+				bus_errors |= bit;
+				continue;
+			}
+			bus_errors &= ~bit;
+			if (batch[i].status & HX711_SAMPLE_IDLE) {
+				bus_idle |= bit;
+			} else {
+				bus_idle &= ~bit;
+			}
+
+			hx711_align_put(&bus_align, &batch[i]);
+		}
+	}
+}
+
+K_THREAD_DEFINE(hx711_bus_tid, CONFIG_HX711_BUS_STACK_SIZE, bus_thread,
+		NULL, NULL, NULL, CONFIG_HX711_BUS_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+int hx711_bus_init(uint8_t num_channels)
+{
+	int ret;
+
+	ret = hx711_align_init(&bus_align, num_channels, bus_aligned, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = hx711_acq_add_consumer(&bus_ring);
+	if (ret < 0) {
+		return ret;
+	}
+
+	bus_channels = num_channels;
+	k_thread_start(hx711_bus_tid);
+
+	return 0;
+}
+
+void hx711_bus_get_info(struct hx711_bus_info *info)
+{
+	*info = bus_info;
+	info->dropped = hx711_ring_overruns(&bus_ring);
+}
+
+#ifdef CONFIG_HX711_SHELL
+static int cmd_hx711_bus(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_bus_info info;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	hx711_bus_get_info(&info);
+	shell_print(sh, "frames %u batches %u dropped %u undelivered %u", info.frames,
+		    info.batches, info.dropped, info.undelivered);
+
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((hx711), bus, NULL, "zbus publication counters", cmd_hx711_bus, 1, 0);
+#endif /* CONFIG_HX711_SHELL */
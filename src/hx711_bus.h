@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_BUS_H_
+#define HX711_BUS_H_
+
+#include "hx711_align.h"
+#include <zephyr/zbus/zbus.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Aligned frames on zbus. Modules attach from their own source file with
+ * ZBUS_CHAN_ADD_OBS() and never touch the driver:
+ *
+ *   hx711_frame_chan  every frame as it is emitted. Meant for listeners,
+ *                     which run on the bus thread and read the frame in
+ *                     place with zbus_chan_const_msg(), so they must be
+ *                     short and must not read the channel.
+ *   hx711_batch_chan  CONFIG_HX711_BUS_BATCH frames at a time. Meant for
+ *                     subscribers, one notification per batch. A
+ *                     subscriber whose queue is full misses the batch and
+ *                     sees the gap in the frame sequence numbers.
+ *
+ * Values are calibrated loads in milli-units with CONFIG_HX711_BUS_LOAD,
+ * counts otherwise. Counts have been through the filter chain when it is
+ * enabled. Channel B of a scanning sensor is always in counts.
+ */
+#define HX711_BUS_MAX_CHANNELS HX711_ALIGN_MAX_CHANNELS
+
+struct hx711_bus_frame {
+	uint32_t seq;         /* Counts every frame since boot */
+	uint32_t timestamp;   /* Grid point, cycle count */
+	uint32_t stale;       /* Bit n set when channel n was held, not interpolated */
+	uint32_t idle;        /* Channel n converts at the idle rate */
+	uint32_t errors;      /* The newest read of channel n failed */
+	uint8_t channels;
+	int32_t values[HX711_BUS_MAX_CHANNELS];
+};
+
+struct hx711_bus_batch {
+	uint8_t count;
+	struct hx711_bus_frame frames[CONFIG_HX711_BUS_BATCH];
+};
+
+struct hx711_bus_info {
+	uint32_t frames;       /* Published since boot */
+	uint32_t batches;
+	uint32_t dropped;      /* Samples lost to a full ring */
+	uint32_t undelivered;  /* Publications that timed out or found a full queue */
+};
+
+ZBUS_CHAN_DECLARE(hx711_frame_chan, hx711_batch_chan);
+
+/* Register the bus consumer, call before hx711_acq_start() */
+int hx711_bus_init(uint8_t num_channels);
+
+void hx711_bus_get_info(struct hx711_bus_info *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_BUS_H_ */
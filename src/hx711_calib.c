@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_calib.h"
+#include "hx711_core.h"
+#include <errno.h>
+#include <string.h>
+
+#define HX711_Q16_ONE (1 << HX711_CALIB_Q)
+
+int hx711_calib_gain_index(uint8_t gain)
+{
+	switch (gain) {
+	case 128:
+		return 0;
+	case 64:
+		return 1;
+	case 32:
+		return 2;
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Q16.16 slope between two points, -ERANGE when it does not fit */
+static int hx711_calib_slope(int64_t d_milli, int64_t d_counts, int32_t *slope_q16)
+{
+	int64_t slope;
+
+	if (d_counts == 0) {
+		return -EINVAL;
+	}
+
+	slope = (d_milli * HX711_Q16_ONE) / d_counts;
+	if (slope == 0 || slope > INT32_MAX || slope < -INT32_MAX) {
+		return -ERANGE;
+	}
+
+	*slope_q16 = (int32_t)slope;
+	return 0;
+}
+
+int hx711_calib_init(struct hx711_calib *calib, uint8_t ref_gain, int32_t offset,
+		     int32_t scale_micro)
+{
+	int64_t scale = ((int64_t)scale_micro * HX711_Q16_ONE) / 1000;
+
+	if (hx711_calib_gain_index(ref_gain) < 0) {
+		return -EINVAL;
+	}
+	if (scale > INT32_MAX || scale < -INT32_MAX) {
+		return -ERANGE;
+	}
+
+	memset(calib, 0, sizeof(*calib));
+	calib->version = HX711_CALIB_VERSION;
+	calib->ref_gain = ref_gain;
+	calib->offset = offset;
+	calib->scale_q16 = (int32_t)scale;
+
+	/* Nominal ratios, counts scale with the PGA gain */
+	calib->gain_corr_q16[0] = (ref_gain * HX711_Q16_ONE) / 128;
+	calib->gain_corr_q16[1] = (ref_gain * HX711_Q16_ONE) / 64;
+	calib->gain_corr_q16[2] = (ref_gain * HX711_Q16_ONE) / 32;
+
+	return 0;
+}
+
+int hx711_calib_set_two_point(struct hx711_calib *calib, int32_t raw0, int32_t milli0,
+			      int32_t raw1, int32_t milli1)
+{
+	int32_t slope;
+	int ret;
+
+	ret = hx711_calib_slope((int64_t)milli1 - milli0, (int64_t)raw1 - raw0, &slope);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Raw count that maps to zero load */
+	calib->offset = raw0 - (int32_t)(((int64_t)milli0 * HX711_Q16_ONE) / slope);
+	calib->scale_q16 = slope;
+	calib->num_points = 0;
+
+	return 0;
+}
+
+int hx711_calib_set_points(struct hx711_calib *calib, const struct hx711_calib_point *points,
+			   size_t num_points)
+{
+	int32_t slopes[CONFIG_HX711_CALIB_MAX_POINTS - 1];
+	int ret;
+
+	if (points == NULL || num_points < 2 || num_points > CONFIG_HX711_CALIB_MAX_POINTS) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i + 1 < num_points; i++) {
+		if (points[i + 1].counts <= points[i].counts) {
+			return -EINVAL;
+		}
+
+		ret = hx711_calib_slope((int64_t)points[i + 1].milli - points[i].milli,
+					(int64_t)points[i + 1].counts - points[i].counts,
+					&slopes[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	memcpy(calib->points, points, num_points * sizeof(points[0]));
+	memcpy(calib->slopes_q16, slopes, (num_points - 1) * sizeof(slopes[0]));
+	calib->num_points = num_points;
+
+	return 0;
+}
+
+int hx711_calib_set_gain_correction(struct hx711_calib *calib, uint8_t gain, int32_t corr_q16)
+{
+	int idx = hx711_calib_gain_index(gain);
+
+	if (idx < 0 || corr_q16 <= 0) {
+		return -EINVAL;
+	}
+
+	calib->gain_corr_q16[idx] = corr_q16;
+	return 0;
+}
+
+int32_t hx711_calib_apply(const struct hx711_calib *calib, int32_t raw, uint8_t gain)
+{
+	int64_t counts = (int64_t)raw - calib->offset;
+	int64_t milli;
+
+	if (gain != calib->ref_gain) {
+		int idx = hx711_calib_gain_index(gain);
+
+		if (idx >= 0) {
+			counts = (counts * calib->gain_corr_q16[idx]) >> HX711_CALIB_Q;
+		}
+	}
+
+	if (calib->num_points < 2) {
+		milli = (counts * calib->scale_q16) >> HX711_CALIB_Q;
+	} else {
+		const struct hx711_calib_point *p = calib->points;
+		uint8_t seg = 0;
+
+		/* Segment n spans points n..n+1, the outer two also extrapolate */
+		while (seg < calib->num_points - 2 && counts >= p[seg + 1].counts) {
+			seg++;
+		}
+
+		milli = p[seg].milli + (((counts - p[seg].counts) * calib->slopes_q16[seg]) >>
+					HX711_CALIB_Q);
+	}
+
+	return hx711_clamp_s32(milli, -INT32_MAX, INT32_MAX);
+}
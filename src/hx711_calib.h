@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_CALIB_H_
+#define HX711_CALIB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Integer calibration from raw counts to milli-units (e.g. grams in mg).
+ * Slopes are Q16.16 milli-units per count and every division happens when
+ * the calibration is set, so hx711_calib_apply() is a subtraction, at most
+ * two 64-bit multiplies and a shift.
+ */
+
+#define HX711_CALIB_Q 16
+
+/* Bump when struct hx711_calib changes meaning without changing size */
+#define HX711_CALIB_VERSION 1
+
+/* Gain correction slots, index with hx711_calib_gain_index() */
+#define HX711_CALIB_GAINS 3
+
+struct hx711_calib_point {
+	int32_t counts;  /* Tared counts at the reference gain */
+	int32_t milli;   /* Load in milli-units */
+};
+
+struct hx711_calib {
+	uint8_t version;
+	uint8_t ref_gain;     /* Gain the slopes were measured at */
+	uint8_t num_points;   /* 0 for a single linear scale */
+	int32_t offset;       /* Raw count at zero load */
+	int32_t scale_q16;    /* Milli-units per count when num_points == 0 */
+	/* Tared counts at another gain times this gives counts at ref_gain */
+	int32_t gain_corr_q16[HX711_CALIB_GAINS];
+	struct hx711_calib_point points[CONFIG_HX711_CALIB_MAX_POINTS];
+	int32_t slopes_q16[CONFIG_HX711_CALIB_MAX_POINTS - 1];
+};
+
+/* 128 -> 0, 64 -> 1, 32 -> 2, -EINVAL otherwise */
+int hx711_calib_gain_index(uint8_t gain);
+
+/* Linear calibration, scale in micro-units per count as in devicetree */
+int hx711_calib_init(struct hx711_calib *calib, uint8_t ref_gain, int32_t offset,
+		     int32_t scale_micro);
+
+/* Two known loads, usually zero and a reference weight, at ref_gain */
+int hx711_calib_set_two_point(struct hx711_calib *calib, int32_t raw0, int32_t milli0,
+			      int32_t raw1, int32_t milli1);
+
+/* Piecewise-linear table, counts strictly increasing, extrapolated at the ends */
+int hx711_calib_set_points(struct hx711_calib *calib, const struct hx711_calib_point *points,
+			   size_t num_points);
+
+/* Override the nominal ref_gain / gain ratio for one gain */
+int hx711_calib_set_gain_correction(struct hx711_calib *calib, uint8_t gain, int32_t corr_q16);
+
+/* Counts to milli-units, saturating to int32_t */
+int32_t hx711_calib_apply(const struct hx711_calib *calib, int32_t raw, uint8_t gain);
+
+struct device;
+
+/*
+ * A sensor's calibration is read by the acquisition thread, the sensor
+ * API and the RTIO decoder while the shell or the application changes it,
+ * so it is only touched under the sensor's lock through these.
+ */
+
+/* hx711_calib_apply() on dev's calibration */
+int32_t hx711_load(const struct device *dev, int32_t raw, uint8_t gain);
+
+void hx711_calib_get(const struct device *dev, struct hx711_calib *calib);
+void hx711_calib_set(const struct device *dev, const struct hx711_calib *calib);
+
+/* Rounded mean of samples channel A conversions, read directly. Only for
+ * sensors nothing else reads, use hx711_acq_mean() once acquisition runs.
+ */
+int hx711_calib_mean(const struct device *dev, uint16_t samples, int32_t *mean);
+
+/* Zero capture: averages samples conversions and makes the mean the offset,
+ * with hx711_calib_mean()'s restriction
+ */
+int hx711_tare(const struct device *dev, uint16_t samples);
+
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+/* Persist dev's calibration under "hx711/<dev name>", restored by settings_load() */
+int hx711_calib_save(const struct device *dev);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_CALIB_H_ */
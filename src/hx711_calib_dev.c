@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Calibration of a live sensor, zero capture and settings persistence */
+
+#include "hx711_calib.h"
+#include "hx711_driver.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+#include <zephyr/settings/settings.h>
+#endif
+
+int32_t hx711_load(const struct device *dev, int32_t raw, uint8_t gain)
+{
+	struct hx711_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->calib_lock);
+	int32_t milli = hx711_calib_apply(&data->calib, raw, gain);
+
+	k_spin_unlock(&data->calib_lock, key);
+
+	return milli;
+}
+
+void hx711_calib_get(const struct device *dev, struct hx711_calib *calib)
+{
+	struct hx711_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->calib_lock);
+
+	*calib = data->calib;
+	k_spin_unlock(&data->calib_lock, key);
+}
+
+void hx711_calib_set(const struct device *dev, const struct hx711_calib *calib)
+{
+	struct hx711_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->calib_lock);
+
+	data->calib = *calib;
+	k_spin_unlock(&data->calib_lock, key);
+}
+
+int hx711_calib_mean(const struct device *dev, uint16_t samples, int32_t *mean)
+{
+	struct hx711_data *data = dev->data;
+	int64_t sum = 0;
+	int32_t value;
+	int ret;
+
+	if (samples == 0) {
+		return -EINVAL;
+	}
+
+	for (uint16_t i = 0; i < samples; i++) {
+		/* Skip settling conversions and, while scanning, channel B */
+		do {
+			ret = hx711_read_raw(dev, &value);
+		} while (ret == -EAGAIN || (ret == 0 && data->scan && data->last_gain == 32));
+		if (ret < 0) {
+			return ret;
+		}
+		sum += value;
+	}
+
+	*mean = hx711_round_mean(sum, samples);
+
+	return 0;
+}
+
+int hx711_tare(const struct device *dev, uint16_t samples)
+{
+	struct hx711_calib calib;
+	int32_t mean;
+	int ret;
+
+	ret = hx711_calib_mean(dev, samples, &mean);
+	if (ret < 0) {
+		return ret;
+	}
+
+	hx711_calib_get(dev, &calib);
+	calib.offset = mean;
+	hx711_calib_set(dev, &calib);
+
+	return 0;
+}
+
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+static const struct device *const hx711_calib_devs[] = { HX711_DT_DEVICES };
+
+int hx711_calib_save(const struct device *dev)
+{
+	struct hx711_calib calib;
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+
+	/* A copy, the store may take a while and must not hold the lock */
+	hx711_calib_get(dev, &calib);
+	snprintk(key, sizeof(key), "hx711/%s", dev->name);
+	return settings_save_one(key, &calib, sizeof(calib));
+}
+
+static int hx711_calib_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+				    void *cb_arg)
+{
+	struct hx711_calib calib;
+	struct hx711_data *data;
+	const char *next;
+	size_t name_len = settings_name_next(name, &next);
+	ssize_t ret;
+
+	if (next != NULL) {
+		return -ENOENT;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_calib_devs); i++) {
+		const struct device *dev = hx711_calib_devs[i];
+
+		if (strlen(dev->name) != name_len || strncmp(dev->name, name, name_len) != 0) {
+			continue;
+		}
+
+		/* A record from a build with another layout is left alone */
+		if (len != sizeof(calib)) {
+			return 0;
+		}
+
+		ret = read_cb(cb_arg, &calib, sizeof(calib));
+		if (ret != sizeof(calib)) {
+			return ret < 0 ? (int)ret : -EINVAL;
+		}
+		if (calib.version != HX711_CALIB_VERSION) {
+			return 0;
+		}
+
+		data = dev->data;
+		hx711_calib_set(dev, &calib);
+		data->calib_restored = true;
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(hx711, "hx711", NULL, hx711_calib_settings_set, NULL, NULL);
+#endif /* CONFIG_HX711_CALIB_SETTINGS */
@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_capture.h"
+#include "hx711_acq.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <stdlib.h>
+#ifdef CONFIG_HX711_SHELL
+#include <zephyr/shell/shell.h>
+#include <string.h>
+#endif
+
+#define CAPTURE_BATCH_SIZE 16
+
+enum capture_state {
+	CAPTURE_FREE,
+	CAPTURE_FILLING,
+	CAPTURE_DONE,
+};
+
+struct capture_channel {
+	struct hx711_capture_trigger trigger;
+	bool armed;            /* ABOVE and BELOW wait to be back past the level */
+	bool seen;             /* min and max hold something */
+	int32_t min;
+	int32_t max;
+	struct hx711_capture_sample hist[CONFIG_HX711_CAPTURE_PRE];
+	uint8_t head;          /* Next slot to write */
+	uint8_t fill;
+	struct hx711_capture *active;
+};
+
+HX711_RING_DEFINE(capture_ring);
+
+/* Serialises the capture thread against the API */
+static K_MUTEX_DEFINE(capture_lock);
+
+static struct capture_channel capture_channels[HX711_ACQ_MAX_CHANNELS];
+static struct hx711_capture capture_records[CONFIG_HX711_CAPTURE_RECORDS];
+static uint8_t capture_state[CONFIG_HX711_CAPTURE_RECORDS];
+static uint8_t capture_num_channels;
+static uint32_t capture_seq;
+static uint32_t capture_missed;      /* Triggers with every record still filling */
+static uint32_t capture_overwritten; /* Completed records replaced unread */
+
+/* A free record, else the oldest completed one */
+static struct hx711_capture *capture_alloc(void)
+{
+	int oldest = -1;
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(capture_records); i++) {
+		if (capture_state[i] == CAPTURE_FREE) {
+			oldest = i;
+			break;
+		}
+		if (capture_state[i] == CAPTURE_DONE &&
+		    (oldest < 0 || capture_records[i].seq < capture_records[oldest].seq)) {
+			oldest = i;
+		}
+	}
+
+	if (oldest < 0) {
+		capture_missed++;
+		return NULL;
+	}
+	if (capture_state[oldest] == CAPTURE_DONE) {
+		capture_overwritten++;
+	}
+
+	capture_state[oldest] = CAPTURE_FILLING;
+	return &capture_records[oldest];
+}
+
+static bool capture_fires(struct capture_channel *ch, int32_t value)
+{
+	const struct hx711_capture_trigger *trig = &ch->trigger;
+	bool fire = false;
+
+	switch (trig->mode) {
+	case HX711_CAPTURE_ABOVE:
+		if (value >= trig->level) {
+			fire = ch->armed;
+			ch->armed = false;
+		} else if (value <= trig->level - trig->hysteresis) {
+			ch->armed = true;
+		}
+		break;
+	case HX711_CAPTURE_BELOW:
+		if (value <= trig->level) {
+			fire = ch->armed;
+			ch->armed = false;
+		} else if (value >= trig->level + trig->hysteresis) {
+			ch->armed = true;
+		}
+		break;
+	case HX711_CAPTURE_STEP:
+		if (ch->fill >= trig->span) {
+			uint8_t back = (ch->head + CONFIG_HX711_CAPTURE_PRE - trig->span) %
+				       CONFIG_HX711_CAPTURE_PRE;
+
+			fire = abs(value - ch->hist[back].value) >= trig->level;
+		}
+		break;
+	default:
+		break;
+	}
+
+	/* A capture in progress takes the trigger's conversions as its own */
+	return fire && ch->active == NULL;
+}
+
+/* Freeze the history, oldest first, into a new record */
+static void capture_start(struct capture_channel *ch, uint8_t channel)
+{
+	struct hx711_capture *rec = capture_alloc();
+
+	if (rec == NULL) {
+		return;
+	}
+
+	rec->seq = capture_seq++;
+	rec->channel = channel;
+	rec->mode = ch->trigger.mode;
+	rec->pre = ch->fill;
+	rec->count = 0;
+	rec->min = INT32_MAX;
+	rec->max = INT32_MIN;
+	for (uint8_t i = 0; i < ch->fill; i++) {
+		const struct hx711_capture_sample *s =
+			&ch->hist[(ch->head + CONFIG_HX711_CAPTURE_PRE - ch->fill + i) %
+				  CONFIG_HX711_CAPTURE_PRE];
+
+		rec->samples[rec->count++] = *s;
+		rec->min = MIN(rec->min, s->value);
+		rec->max = MAX(rec->max, s->value);
+	}
+
+	ch->active = rec;
+}
+
+static void capture_append(struct capture_channel *ch, const struct hx711_capture_sample *s)
+{
+	struct hx711_capture *rec = ch->active;
+
+	rec->samples[rec->count++] = *s;
+	rec->min = MIN(rec->min, s->value);
+	rec->max = MAX(rec->max, s->value);
+
+	if (rec->count == rec->pre + CONFIG_HX711_CAPTURE_POST) {
+		capture_state[rec - capture_records] = CAPTURE_DONE;
+		ch->active = NULL;
+	}
+}
+
+static void capture_put(const struct hx711_sample *sample)
+{
+	struct capture_channel *ch;
+	struct hx711_capture_sample s = {
+		.timestamp = sample->timestamp,
+		.value = sample->raw,
+	};
+
+	if (sample->sensor_id >= capture_num_channels) {
+		return;
+	}
+	ch = &capture_channels[sample->sensor_id];
+
+	/* A step across a failed read is not the load moving */
+	if (sample->status & HX711_SAMPLE_ERROR) {
+		ch->fill = 0;
+		return;
+	}
+
+	if (!ch->seen) {
+		ch->min = ch->max = s.value;
+		ch->seen = true;
+	}
+	ch->min = MIN(ch->min, s.value);
+	ch->max = MAX(ch->max, s.value);
+
+	if (capture_fires(ch, s.value)) {
+		capture_start(ch, sample->sensor_id);
+	}
+	if (ch->active != NULL) {
+		capture_append(ch, &s);
+	}
+
+	ch->hist[ch->head] = s;
+	ch->head = (ch->head + 1) % CONFIG_HX711_CAPTURE_PRE;
+	ch->fill = MIN(ch->fill + 1, CONFIG_HX711_CAPTURE_PRE);
+}
+
+static void capture_thread(void *p1, void *p2, void *p3)
+{
+	struct hx711_sample batch[CAPTURE_BATCH_SIZE];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		size_t count = hx711_ring_get(&capture_ring, batch, ARRAY_SIZE(batch), K_FOREVER);
+
+		k_mutex_lock(&capture_lock, K_FOREVER);
+		for (size_t i = 0; i < count; i++) {
+			capture_put(&batch[i]);
+		}
+		k_mutex_unlock(&capture_lock);
+	}
+}
+
+K_THREAD_DEFINE(hx711_capture_tid, CONFIG_HX711_CAPTURE_STACK_SIZE, capture_thread,
+		NULL, NULL, NULL, CONFIG_HX711_CAPTURE_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+int hx711_capture_init(uint8_t num_channels)
+{
+	int ret;
+
+	if (num_channels == 0 || num_channels > ARRAY_SIZE(capture_channels)) {
+		return -EINVAL;
+	}
+
+	ret = hx711_acq_add_tap(&capture_ring);
+	if (ret < 0) {
+		return ret;
+	}
+
+	capture_num_channels = num_channels;
+	k_thread_start(hx711_capture_tid);
+
+	return 0;
+}
+
+int hx711_capture_set_trigger(uint8_t channel, const struct hx711_capture_trigger *trigger)
+{
+	struct capture_channel *ch;
+
+	if (channel >= capture_num_channels || !trigger || trigger->mode > HX711_CAPTURE_STEP ||
+	    trigger->hysteresis < 0) {
+		return -EINVAL;
+	}
+
+	if (trigger->mode == HX711_CAPTURE_STEP &&
+	    (trigger->span == 0 || trigger->span > CONFIG_HX711_CAPTURE_PRE || trigger->level <= 0)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&capture_lock, K_FOREVER);
+	ch = &capture_channels[channel];
+	ch->trigger = *trigger;
+	/* A level already crossed when armed does not fire */
+	ch->armed = false;
+	k_mutex_unlock(&capture_lock);
+
+	return 0;
+}
+
+int hx711_capture_read(uint8_t n, struct hx711_capture *capture)
+{
+	uint32_t after = 0;
+	int found = -1;
+
+	if (!capture) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&capture_lock, K_FOREVER);
+
+	/* The n + 1 oldest by sequence number, there are only a few records */
+	for (uint16_t k = 0; k <= n; k++) {
+		found = -1;
+		for (uint8_t i = 0; i < ARRAY_SIZE(capture_records); i++) {
+			if (capture_state[i] != CAPTURE_DONE ||
+			    (k > 0 && capture_records[i].seq <= after)) {
+				continue;
+			}
+			if (found < 0 || capture_records[i].seq < capture_records[found].seq) {
+				found = i;
+			}
+		}
+		if (found < 0) {
+			break;
+		}
+		after = capture_records[found].seq;
+	}
+
+	if (found >= 0) {
+		*capture = capture_records[found];
+	}
+
+	k_mutex_unlock(&capture_lock);
+
+	return found < 0 ? -ENOENT : 0;
+}
+
+void hx711_capture_clear(void)
+{
+	k_mutex_lock(&capture_lock, K_FOREVER);
+	for (uint8_t i = 0; i < ARRAY_SIZE(capture_records); i++) {
+		if (capture_state[i] == CAPTURE_DONE) {
+			capture_state[i] = CAPTURE_FREE;
+		}
+	}
+	k_mutex_unlock(&capture_lock);
+}
+
+int hx711_capture_peaks(uint8_t channel, int32_t *min, int32_t *max)
+{
+	int ret = -ENODATA;
+
+	if (channel >= capture_num_channels || !min || !max) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&capture_lock, K_FOREVER);
+	if (capture_channels[channel].seen) {
+		*min = capture_channels[channel].min;
+		*max = capture_channels[channel].max;
+		ret = 0;
+	}
+	k_mutex_unlock(&capture_lock);
+
+	return ret;
+}
+
+void hx711_capture_peaks_reset(void)
+{
+	k_mutex_lock(&capture_lock, K_FOREVER);
+	for (uint8_t i = 0; i < capture_num_channels; i++) {
+		capture_channels[i].seen = false;
+	}
+	k_mutex_unlock(&capture_lock);
+}
+
+#ifdef CONFIG_HX711_SHELL
+static const char *const capture_mode_names[] = {
+	[HX711_CAPTURE_OFF] = "off",
+	[HX711_CAPTURE_ABOVE] = "above",
+	[HX711_CAPTURE_BELOW] = "below",
+	[HX711_CAPTURE_STEP] = "step",
+};
+
+/* Reused by list and show, a record is too big for the shell stack */
+static struct hx711_capture capture_shell_rec;
+
+static int cmd_hx711_capture_arm(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_capture_trigger trigger = {0};
+	uint8_t channel = strtoul(argv[1], NULL, 0);
+	int ret;
+
+	for (uint8_t i = HX711_CAPTURE_ABOVE; i < ARRAY_SIZE(capture_mode_names); i++) {
+		if (strcmp(argv[2], capture_mode_names[i]) == 0) {
+			trigger.mode = i;
+		}
+	}
+	if (trigger.mode == HX711_CAPTURE_OFF) {
+		shell_error(sh, "Mode is above, below or step");
+		return -EINVAL;
+	}
+
+	trigger.level = strtol(argv[3], NULL, 0);
+	if (trigger.mode == HX711_CAPTURE_STEP) {
+		trigger.span = argc > 4 ? strtoul(argv[4], NULL, 0) : 1;
+	} else if (argc > 4) {
+		trigger.hysteresis = strtol(argv[4], NULL, 0);
+	}
+
+	ret = hx711_capture_set_trigger(channel, &trigger);
+	if (ret < 0) {
+		shell_error(sh, "Invalid trigger: %d", ret);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_capture_off(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_capture_trigger trigger = { .mode = HX711_CAPTURE_OFF };
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	ret = hx711_capture_set_trigger(strtoul(argv[1], NULL, 0), &trigger);
+	if (ret < 0) {
+		shell_error(sh, "No channel %s", argv[1]);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_capture_list(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "missed %u overwritten %u dropped %u", capture_missed,
+		    capture_overwritten, hx711_ring_overruns(&capture_ring));
+	for (uint8_t n = 0; hx711_capture_read(n, &capture_shell_rec) == 0; n++) {
+		shell_print(sh, "%u: seq %u ch %u %s, %u+%u samples, min %d max %d", n,
+			    capture_shell_rec.seq, capture_shell_rec.channel,
+			    capture_mode_names[capture_shell_rec.mode], capture_shell_rec.pre,
+			    capture_shell_rec.count - capture_shell_rec.pre, capture_shell_rec.min,
+			    capture_shell_rec.max);
+	}
+
+	return 0;
+}
+
+static int cmd_hx711_capture_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct hx711_capture *rec = &capture_shell_rec;
+	uint32_t trig;
+
+	ARG_UNUSED(argc);
+
+	if (hx711_capture_read(strtoul(argv[1], NULL, 0), &capture_shell_rec) < 0) {
+		shell_error(sh, "No capture %s", argv[1]);
+		return -ENOENT;
+	}
+
+	/* Times are relative to the triggering conversion */
+	trig = rec->samples[rec->pre].timestamp;
+	shell_print(sh, "time_us,value");
+	for (uint16_t i = 0; i < rec->count; i++) {
+		int32_t dt = (int32_t)(rec->samples[i].timestamp - trig);
+
+		shell_print(sh, "%s%u,%d", dt < 0 ? "-" : "", k_cyc_to_us_near32(abs(dt)),
+			    rec->samples[i].value);
+	}
+
+	return 0;
+}
+
+static int cmd_hx711_capture_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	hx711_capture_clear();
+	shell_print(sh, "Captures cleared");
+
+	return 0;
+}
+
+static int cmd_hx711_capture_peaks(const struct shell *sh, size_t argc, char **argv)
+{
+	int32_t min, max;
+
+	for (uint8_t i = 0; i < capture_num_channels; i++) {
+		if (hx711_capture_peaks(i, &min, &max) == 0) {
+			shell_print(sh, "ch %u: min %d max %d", i, min, max);
+		}
+	}
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		hx711_capture_peaks_reset();
+		shell_print(sh, "Peaks reset");
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_hx711_capture,
+	SHELL_CMD_ARG(arm, NULL,
+		      "<channel> <above|below|step> <level> [hysteresis|span]",
+		      cmd_hx711_capture_arm, 4, 1),
+	SHELL_CMD_ARG(off, NULL, "<channel>", cmd_hx711_capture_off, 2, 0),
+	SHELL_CMD(list, NULL, "Completed captures, oldest first", cmd_hx711_capture_list),
+	SHELL_CMD_ARG(show, NULL, "Print capture <n> as CSV", cmd_hx711_capture_show, 2, 0),
+	SHELL_CMD(clear, NULL, "Drop the completed captures", cmd_hx711_capture_clear),
+	SHELL_CMD_ARG(peaks, NULL, "Per-channel min and max, then [reset]",
+		      cmd_hx711_capture_peaks, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((hx711), capture, &sub_hx711_capture, "Triggered event captures", NULL, 1, 0);
+#endif /* CONFIG_HX711_SHELL */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_CAPTURE_H_
+#define HX711_CAPTURE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Event capture on the full-rate tap (see hx711_acq_add_tap()). Every
+ * channel keeps its last CONFIG_HX711_CAPTURE_PRE conversions. When the
+ * channel's trigger fires, those and the next CONFIG_HX711_CAPTURE_POST
+ * conversions, the triggering one first, are frozen into a capture
+ * record. The newest CONFIG_HX711_CAPTURE_RECORDS records are kept in
+ * RAM until read, a new one replaces the oldest.
+ *
+ * Values are counts after the spike and low-pass stages. Every channel
+ * also holds its minimum and maximum since the last peak reset.
+ */
+#define HX711_CAPTURE_SAMPLES (CONFIG_HX711_CAPTURE_PRE + CONFIG_HX711_CAPTURE_POST)
+
+enum hx711_capture_mode {
+	HX711_CAPTURE_OFF,
+	HX711_CAPTURE_ABOVE,   /* Rises to level or beyond */
+	HX711_CAPTURE_BELOW,   /* Falls to level or below */
+	HX711_CAPTURE_STEP,    /* Moves by level or more over span conversions */
+};
+
+struct hx711_capture_trigger {
+	enum hx711_capture_mode mode;
+	int32_t level;
+	/* ABOVE and BELOW rearm once the value is back this far past level */
+	int32_t hysteresis;
+	/* STEP compares against the conversion this many back, at most PRE */
+	uint8_t span;
+};
+
+struct hx711_capture_sample {
+	uint32_t timestamp;    /* Cycle count at data ready */
+	int32_t value;
+};
+
+struct hx711_capture {
+	uint32_t seq;          /* Counts every capture since boot */
+	uint8_t channel;
+	uint8_t mode;          /* enum hx711_capture_mode that fired */
+	uint16_t pre;          /* Samples before the trigger, up to PRE */
+	uint16_t count;        /* Samples held */
+	int32_t min;           /* Over the samples held */
+	int32_t max;
+	struct hx711_capture_sample samples[HX711_CAPTURE_SAMPLES];
+};
+
+/* Register the capture tap, call before hx711_acq_start(). Triggers start off. */
+int hx711_capture_init(uint8_t num_channels);
+
+int hx711_capture_set_trigger(uint8_t channel, const struct hx711_capture_trigger *trigger);
+
+/* Completed record n, 0 the oldest held. -ENOENT past the newest. */
+int hx711_capture_read(uint8_t n, struct hx711_capture *capture);
+
+/* Drop every completed record */
+void hx711_capture_clear(void);
+
+/* Extremes since boot or the last reset, -ENODATA before the first conversion */
+int hx711_capture_peaks(uint8_t channel, int32_t *min, int32_t *max);
+void hx711_capture_peaks_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_CAPTURE_H_ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_CORE_H_
+#define HX711_CORE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Conversion math shared with the host replay library in host/. This
+ * header, hx711_calib.c and hx711_filter.c include nothing from Zephyr,
+ * so an offline run over a capture computes what the device computed.
+ */
+
+/* Convert a 24-bit two's complement conversion to int32_t */
+static inline int32_t hx711_sign_extend(int32_t raw_value)
+{
+	if (raw_value & 0x800000) {
+		raw_value |= 0xFF000000;  /* Sign extend negative values */
+	}
+
+	return raw_value;
+}
+
+static inline int32_t hx711_clamp_s32(int64_t value, int32_t min, int32_t max)
+{
+	return (int32_t)(value < min ? min : (value > max ? max : value));
+}
+
+/* Mean of count conversions summing to sum, rounded half away from zero */
+static inline int32_t hx711_round_mean(int64_t sum, uint32_t count)
+{
+	sum += (sum < 0) ? -(int64_t)(count / 2) : (int64_t)(count / 2);
+
+	return (int32_t)(sum / count);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_CORE_H_ */
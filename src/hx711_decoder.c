@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_driver.h"
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/dsp/types.h>
+
+#define DT_DRV_COMPAT avia_hx711
+
+/* A 24-bit count fits q31 with 23 integer bits, raw << 8 keeps every bit */
+#define HX711_RAW_SHIFT 23
+
+static bool hx711_decoder_supported(struct sensor_chan_spec chan_spec)
+{
+	return chan_spec.chan_idx == 0 &&
+	       (chan_spec.chan_type == (uint16_t)SENSOR_CHAN_HX711_RAW ||
+		chan_spec.chan_type == (uint16_t)SENSOR_CHAN_HX711_LOAD);
+}
+
+static int hx711_decoder_get_frame_count(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+					 uint16_t *frame_count)
+{
+	const struct hx711_encoded_data *edata = (const struct hx711_encoded_data *)buffer;
+
+	if (!hx711_decoder_supported(chan_spec)) {
+		return -ENOTSUP;
+	}
+
+	*frame_count = edata->has_sample ? 1 : 0;
+	return 0;
+}
+
+static int hx711_decoder_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size,
+				       size_t *frame_size)
+{
+	if (!hx711_decoder_supported(chan_spec)) {
+		return -ENOTSUP;
+	}
+
+	*base_size = sizeof(struct sensor_q31_data);
+	*frame_size = sizeof(struct sensor_q31_sample_data);
+	return 0;
+}
+
+/* Milli-units with the smallest shift that fits */
+static q31_t hx711_load_to_q31(const struct hx711_encoded_data *edata, int8_t *shift)
+{
+	int64_t milli = edata->load_milli;
+	int64_t mag = milli < 0 ? -milli : milli;
+	int8_t s = 0;
+
+	while (mag >= (1000LL << s)) {
+		s++;
+	}
+
+	*shift = s;
+	return (q31_t)((milli * (1LL << (31 - s))) / 1000);
+}
+
+static int hx711_decoder_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				uint32_t *fit, uint16_t max_count, void *data_out)
+{
+	const struct hx711_encoded_data *edata = (const struct hx711_encoded_data *)buffer;
+	struct sensor_q31_data *out = data_out;
+
+	if (!hx711_decoder_supported(chan_spec)) {
+		return -ENOTSUP;
+	}
+
+	/* One conversion per buffer */
+	if (*fit != 0 || max_count == 0 || !edata->has_sample) {
+		return 0;
+	}
+
+	out->header.base_timestamp_ns = edata->timestamp_ns;
+	out->header.reading_count = 1;
+	out->readings[0].timestamp_delta = 0;
+
+	if (chan_spec.chan_type == (uint16_t)SENSOR_CHAN_HX711_RAW) {
+		out->shift = HX711_RAW_SHIFT;
+		out->readings[0].value = (q31_t)(edata->raw * (1 << (31 - HX711_RAW_SHIFT)));
+	} else {
+		out->readings[0].value = hx711_load_to_q31(edata, &out->shift);
+	}
+
+	*fit = 1;
+	return 1;
+}
+
+static bool hx711_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
+{
+	const struct hx711_encoded_data *edata = (const struct hx711_encoded_data *)buffer;
+
+	return trigger == SENSOR_TRIG_DATA_READY && edata->drdy;
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+	.get_frame_count = hx711_decoder_get_frame_count,
+	.get_size_info = hx711_decoder_get_size_info,
+	.decode = hx711_decoder_decode,
+	.has_trigger = hx711_decoder_has_trigger,
+};
+
+int hx711_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &SENSOR_DECODER_NAME();
+	return 0;
+}
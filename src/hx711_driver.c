@@ -6,208 +6,1276 @@
 #include "hx711_driver.h"
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/pm/device.h>
 #include <zephyr/sys/util.h>
 #include  <stdint.h>
 #include <zephyr/sys/printk.h>
+#ifdef CONFIG_HX711_FAST_READ
+#include <hal/nrf_gpio.h>
+#endif
+#ifdef CONFIG_HX711_CLOCK_GUARD
+#include <zephyr/timing/timing.h>
 
-int hx711_init(struct hx711_data *hx711, 
-               const struct device *dout_dev, gpio_pin_t dout_pin, gpio_flags_t dout_flags,
-               const struct device *sck_dev, gpio_pin_t sck_pin, gpio_flags_t sck_flags)
+#define HX711_CLOCK_RETRIES CONFIG_HX711_CLOCK_RETRIES
+#else
+#define HX711_CLOCK_RETRIES 0
+#endif
+
+static bool hx711_uses_spi(const struct device *dev)
 {
-	int ret;
+#ifdef CONFIG_HX711_SPI
+	const struct hx711_config *cfg = dev->config;
 
-	if (!hx711 || !dout_dev || !sck_dev) {
-		return -EINVAL;
+	return cfg->use_spi;
+#else
+	ARG_UNUSED(dev);
+	return false;
+#endif
+}
+
+static bool hx711_valid_gain(uint8_t gain)
+{
+	return gain == 128 || gain == 64 || gain == 32;
+}
+
+/* RATE high selects 80 SPS, without the pin only the strapped rate exists */
+static int hx711_apply_rate(const struct device *dev, uint8_t sps)
+{
+	const struct hx711_config *cfg = dev->config;
+
+	if (cfg->rate.port == NULL) {
+		return sps == cfg->sps ? 0 : -ENOTSUP;
+	}
+
+	return gpio_pin_set_dt(&cfg->rate, sps == 80);
+}
+
+/* Rate of the conversion in progress */
+static uint8_t hx711_active_sps(const struct hx711_data *data)
+{
+	return (data->scan && data->gain == 32) ? data->scan_b_sps : data->rate_sps;
+}
+
+/*
+ * Book-keeping for one clocked-out conversion. The pulses just sent made
+ * next_gain the gain of the conversion now starting; returns false when the
+ * conversion just read was taken while the input was still settling.
+ */
+bool hx711_conversion_done(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+	bool valid = data->settle == 0 && sys_timepoint_expired(data->ready_at);
+
+	/* Inside the settle window the discard count may already be spent */
+	if (data->settle > 0) {
+		data->settle--;
 	}
+	data->last_gain = data->gain;
 
-	/* Store device handles */
-	hx711->dout_dev = dout_dev;
-	hx711->sck_dev = sck_dev;
+	if (data->next_gain != data->gain) {
+		data->gain = data->next_gain;
+		data->settle = CONFIG_HX711_SETTLE_DISCARD;
+		if (data->scan) {
+			(void)hx711_apply_rate(dev, hx711_active_sps(data));
+		}
+	}
+
+	/* Switch again once the current channel has produced a valid conversion */
+	if (data->scan && data->settle == 0) {
+		data->next_gain = (data->gain == 32) ? data->gain_a : 32;
+	}
 
-	/* Store pin information */
-	hx711->dout_pin = dout_pin;
-	hx711->sck_pin = sck_pin;
-	hx711->dout_flags = dout_flags;
-	hx711->sck_flags = sck_flags;
+	return valid;
+}
+
+#ifdef CONFIG_HX711_TRIGGER
+static void hx711_dout_callback(const struct device *port, struct gpio_callback *cb,
+				uint32_t pins)
+{
+	struct hx711_data *data = CONTAINER_OF(cb, struct hx711_data, dout_cb);
 
-	/* Configure DOUT pin as input with pull-up */
-	ret = gpio_pin_configure(hx711->dout_dev, dout_pin, dout_flags);
+	ARG_UNUSED(port);
+	ARG_UNUSED(pins);
+
+	data->drdy_cycles = k_cycle_get_32();
+	k_sem_give(&data->drdy_sem);
+#ifdef CONFIG_HX711_ASYNC
+	hx711_async_drdy(data);
+#endif
+}
+
+static int hx711_drdy_irq_enable(const struct device *dev, bool enable)
+{
+	const struct hx711_config *cfg = dev->config;
+
+	return gpio_pin_interrupt_configure_dt(&cfg->dout,
+					       enable ? GPIO_INT_EDGE_FALLING : GPIO_INT_DISABLE);
+}
+
+static int hx711_trigger_init(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
+	int ret;
+
+	k_sem_init(&data->drdy_sem, 0, 1);
+	data->rebase = true;
+
+	gpio_init_callback(&data->dout_cb, hx711_dout_callback, BIT(cfg->dout.pin));
+	ret = gpio_add_callback_dt(&cfg->dout, &data->dout_cb);
 	if (ret < 0) {
-		printk("Failed to configure DOUT pin: %d\n", ret);
+		printk("%s: failed to add DOUT callback: %d\n", dev->name, ret);
 		return ret;
 	}
 
-	/* Configure SCK pin as output, initially low */
-	ret = gpio_pin_configure(hx711->sck_dev, sck_pin, sck_flags);
+	ret = hx711_drdy_irq_enable(dev, true);
 	if (ret < 0) {
-		printk("Failed to configure SCK pin: %d\n", ret);
+		printk("%s: failed to configure DOUT interrupt: %d\n", dev->name, ret);
 		return ret;
 	}
 
-	/* Power up delay - HX711 needs time to stabilize */
-	k_msleep(400);
+	return 0;
+}
 
-	/* Set default rate */
-	hx711->rate_sps = HX711_DEFAULT_RATE_SPS;
+/* Account for the conversion that is about to be clocked out */
+static void hx711_account_read(struct hx711_data *data)
+{
+	uint32_t edge = data->drdy_cycles;
+	uint32_t period = sys_clock_hw_cycles_per_sec() / hx711_active_sps(data);
+	uint32_t latency = k_cycle_get_32() - edge;
 
-	hx711->is_initialized = true;
+	HX711_STATS_LATENCY(&data->stats, latency);
+
+	/* Edges that are whole periods apart mean conversions were skipped */
+	if (!data->rebase && edge != data->last_read_cycles) {
+		uint32_t elapsed = (edge - data->last_read_cycles + period / 2) / period;
+
+		if (elapsed > 1) {
+			HX711_STATS_ADD(&data->stats, missed, elapsed - 1);
+		}
+	}
+
+	/* DOUT stays low while unread, so stale data hides further conversions.
+	 * Those are charged here, so the next gap is measured from the last one.
+	 */
+	if (latency >= period) {
+		HX711_STATS_ADD(&data->stats, missed, latency / period);
+	}
+
+	data->last_read_cycles = edge + (latency / period) * period;
+	data->rebase = false;
+}
+#endif /* CONFIG_HX711_TRIGGER */
+
+/* Output settling time after power up or reset, from the datasheet */
+static k_timeout_t hx711_settle_time(uint8_t sps)
+{
+	return sps == 80 ? K_MSEC(50) : K_MSEC(400);
+}
+
+static int hx711_power_down(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+	int ret;
+
+	/* PD_SCK belongs to the SPI controller and idles low */
+	if (hx711_uses_spi(dev)) {
+		return -ENOTSUP;
+	}
+
+	/* Set SCK high to enter sleep mode */
+	ret = gpio_pin_set_dt(&cfg->sck, 1);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Wait for sleep mode to take effect (>60us required) */
+	k_busy_wait(HX711_SLEEP_DELAY_US);
 
 	return 0;
 }
 
-int hx711_read_raw(struct hx711_data *hx711, int32_t *value)
+/* Does not wait for the output to settle, reads discard conversions until then */
+static int hx711_power_up(const struct device *dev)
 {
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
 	int ret;
-	int32_t raw_value = 0;
-	uint8_t i;
 
-	if (!hx711 || !value || !hx711->is_initialized) {
-		return -EINVAL;
+	/* Power down resets the chip to channel A, gain 128 */
+	data->gain = 128;
+	data->settle = CONFIG_HX711_SETTLE_DISCARD;
+
+	if (cfg->rate.port != NULL) {
+		ret = gpio_pin_set_dt(&cfg->rate, data->rate_sps == 80);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
-	/* Wait for data to be ready - use shorter timeout */
-	ret = hx711_wait_for_data(hx711, K_MSEC(50));
+	if (!hx711_uses_spi(dev)) {
+		/* Set SCK low to wake up */
+		ret = gpio_pin_set_dt(&cfg->sck, 0);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	data->ready_at = sys_timepoint_calc(hx711_settle_time(data->rate_sps));
+#ifdef CONFIG_HX711_TRIGGER
+	/* The gap is not lost conversions, and an edge before now is stale */
+	data->rebase = true;
+	k_sem_reset(&data->drdy_sem);
+#endif
+
+	return 0;
+}
+
+static int hx711_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+		return hx711_power_down(dev);
+	case PM_DEVICE_ACTION_RESUME:
+		return hx711_power_up(dev);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+/* Shortest SCK high and low phases, datasheet T3 and T4 */
+#define HX711_SCK_MIN_NS 200
+
+#if DT_NODE_HAS_PROP(DT_PATH(cpus, cpu_0), clock_frequency)
+/* Every nop takes at least one CPU cycle, the loop only adds to that */
+#define HX711_SCK_MIN_NOPS                                                          \
+	DIV_ROUND_UP((uint64_t)DT_PROP(DT_PATH(cpus, cpu_0), clock_frequency) *    \
+		     HX711_SCK_MIN_NS, NSEC_PER_SEC)
+
+static ALWAYS_INLINE void hx711_sck_delay(void)
+{
+	for (uint32_t i = 0; i < HX711_SCK_MIN_NOPS; i++) {
+		arch_nop();
+	}
+}
+#else
+/* No CPU clock to count cycles against */
+static ALWAYS_INLINE void hx711_sck_delay(void)
+{
+	k_busy_wait(1);
+}
+#endif
+
+#ifdef CONFIG_HX711_CLOCK_GUARD
+/* In timing counter cycles */
+static uint32_t hx711_sck_min;
+static uint32_t hx711_sck_max;        /* CONFIG_HX711_SCK_HIGH_MAX_US */
+static uint32_t hx711_sck_power_down; /* HX711_POWER_DOWN_US */
+
+static void hx711_guard_init(void)
+{
+	uint64_t hz;
+
+	timing_init();
+	timing_start();
+	hz = timing_freq_get();
+	hx711_sck_min = DIV_ROUND_UP(hz * HX711_SCK_MIN_NS, NSEC_PER_SEC);
+	hx711_sck_max = hz * CONFIG_HX711_SCK_HIGH_MAX_US / USEC_PER_SEC;
+	hx711_sck_power_down = hz * HX711_POWER_DOWN_US / USEC_PER_SEC;
+}
+
+static inline uint32_t hx711_guard_since(timing_t start)
+{
+	timing_t now = timing_counter_get();
+
+	return (uint32_t)timing_cycles_get(&start, &now);
+}
+#endif /* CONFIG_HX711_CLOCK_GUARD */
+
+static int hx711_init(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
+	int ret;
+
+	data->dev = dev;
+
+	ret = hx711_calib_init(&data->calib, cfg->gain, cfg->offset, cfg->scale);
 	if (ret < 0) {
+		printk("%s: scale out of range: %d\n", dev->name, ret);
 		return ret;
 	}
 
-	/* Read 24 bits of data */
-	for (i = 0; i < 24; i++) {
-		/* Clock high */
-		ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 1);
+	if (!gpio_is_ready_dt(&cfg->dout)) {
+		printk("%s: DOUT GPIO not ready\n", dev->name);
+		return -ENODEV;
+	}
+
+	/* Configure DOUT pin as input, pull-up comes from devicetree */
+	ret = gpio_pin_configure_dt(&cfg->dout, GPIO_INPUT);
+	if (ret < 0) {
+		printk("%s: failed to configure DOUT pin: %d\n", dev->name, ret);
+		return ret;
+	}
+
+#ifdef CONFIG_HX711_SPI
+	if (cfg->use_spi && !spi_is_ready_dt(&cfg->spi)) {
+		printk("%s: SPI bus %s not ready\n", dev->name, cfg->spi.bus->name);
+		return -ENODEV;
+	}
+#endif
+
+	if (!hx711_uses_spi(dev)) {
+		if (!gpio_is_ready_dt(&cfg->sck)) {
+			printk("%s: SCK GPIO not ready\n", dev->name);
+			return -ENODEV;
+		}
+
+		/* SCK starts high, which resets a chip that kept power over an MCU
+		 * reset to channel A, gain 128, and keeps it down until resumed
+		 */
+		ret = gpio_pin_configure_dt(&cfg->sck, GPIO_OUTPUT_ACTIVE);
 		if (ret < 0) {
+			printk("%s: failed to configure SCK pin: %d\n", dev->name, ret);
 			return ret;
 		}
-		k_busy_wait(1);
+		k_busy_wait(HX711_SLEEP_DELAY_US);
+#ifdef CONFIG_HX711_CLOCK_GUARD
+		hx711_guard_init();
+#endif
+	}
+
+	/* Resume starts on channel A, gain 128, the first read selects cfg->gain */
+	data->gain = 128;
+	data->last_gain = 128;
+	data->next_gain = cfg->gain;
+	data->gain_a = (cfg->gain == 32) ? 128 : cfg->gain;
+	data->scan = cfg->scan;
+	data->scan_b_sps = cfg->scan_b_sps;
 
-		/* Read data bit */
-		int data_bit = gpio_pin_get(hx711->dout_dev, hx711->dout_pin);
-		if (data_bit < 0) {
-			return data_bit;
+	/* RATE high selects 80 SPS */
+	data->rate_sps = cfg->sps;
+	if (cfg->rate.port != NULL) {
+		ret = gpio_pin_configure_dt(&cfg->rate, data->rate_sps == 80 ?
+					    GPIO_OUTPUT_ACTIVE : GPIO_OUTPUT_INACTIVE);
+		if (ret < 0) {
+			printk("%s: failed to configure RATE pin: %d\n", dev->name, ret);
+			return ret;
 		}
+	}
+
+#ifdef CONFIG_HX711_ASYNC
+	hx711_async_init(dev);
+#endif
+
+#ifdef CONFIG_HX711_STATS
+	hx711_stats_init(dev);
+#endif
+
+#ifdef CONFIG_HX711_TRIGGER
+	ret = hx711_trigger_init(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
+	/* Resumes right away unless runtime PM keeps the device suspended. There is
+	 * no settling delay here, so every instance shares one settle window.
+	 */
+	return pm_device_driver_init(dev, hx711_pm_action);
+}
+
+/*
+ * One SCK pulse is begin, rising edge, high, falling edge, end. With
+ * HX711_CLOCK_GUARD interrupts are masked from just before the rising
+ * edge to just after the falling one, the phases last the datasheet
+ * minimum by the timing counter and the high phase is measured, since
+ * zero latency interrupts and bus stalls still get through. Without it
+ * each phase is a nop loop of at least the minimum and nothing is
+ * measured.
+ */
+struct hx711_sck_phase {
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	unsigned int key;
+	timing_t rise;
+#endif
+};
+
+static inline void hx711_phase_begin(struct hx711_sck_phase *phase)
+{
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	phase->key = irq_lock();
+#else
+	ARG_UNUSED(phase);
+#endif
+}
+
+static inline void hx711_phase_high(struct hx711_sck_phase *phase)
+{
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	phase->rise = timing_counter_get();
+	while (hx711_guard_since(phase->rise) < hx711_sck_min) {
+	}
+#else
+	ARG_UNUSED(phase);
+	hx711_sck_delay();
+#endif
+}
+
+/* Returns how long SCK was high in timing counter cycles, 0 if not measured */
+static inline uint32_t hx711_phase_end(struct hx711_sck_phase *phase)
+{
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	timing_t fall = timing_counter_get();
+	uint32_t high;
+
+	irq_unlock(phase->key);
+	high = (uint32_t)timing_cycles_get(&phase->rise, &fall);
+	while (hx711_guard_since(fall) < hx711_sck_min) {
+	}
+
+	return high;
+#else
+	ARG_UNUSED(phase);
+	hx711_sck_delay();
+	return 0;
+#endif
+}
+
+/* Longest SCK high phase of a frame over CONFIG_HX711_SCK_HIGH_MAX_US */
+static bool hx711_frame_stretched(uint32_t high_max)
+{
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	return high_max > hx711_sck_max;
+#else
+	ARG_UNUSED(high_max);
+	return false;
+#endif
+}
+
+/*
+ * A stretched frame may hold garbage and fails with -EBADMSG. Past
+ * HX711_POWER_DOWN_US the chip went to sleep and woke up reset, so it is
+ * power cycled on purpose to leave it in a known state: channel A, gain
+ * 128, settling.
+ */
+static int hx711_check_frame(const struct device *dev, uint32_t high_max)
+{
+#ifdef CONFIG_HX711_CLOCK_GUARD
+	struct hx711_data *data = dev->data;
+
+	if (!hx711_frame_stretched(high_max)) {
+		return 0;
+	}
+
+	HX711_STATS_INC(&data->stats, stretched);
+	if (high_max >= hx711_sck_power_down) {
+		(void)hx711_power_down(dev);
+		(void)hx711_power_up(dev);
+	}
+
+	return -EBADMSG;
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(high_max);
+	return 0;
+#endif
+}
+
+/* One SCK pulse, DOUT is sampled before the falling edge when bit is not NULL */
+static int hx711_clock_pulse(const struct hx711_config *cfg, int *bit, uint32_t *high_max)
+{
+	struct hx711_sck_phase phase;
+	int ret, err;
+
+	hx711_phase_begin(&phase);
+	ret = gpio_pin_set_dt(&cfg->sck, 1);
+	hx711_phase_high(&phase);
+	if (ret == 0 && bit != NULL) {
+		*bit = gpio_pin_get_dt(&cfg->dout);
+		ret = MIN(*bit, 0);
+	}
+	err = gpio_pin_set_dt(&cfg->sck, 0);
+	*high_max = MAX(*high_max, hx711_phase_end(&phase));
+
+	return ret < 0 ? ret : err;
+}
+
+static int hx711_clock_out(const struct device *dev, int32_t *value, uint32_t *high_max)
+{
+	const struct hx711_config *cfg = dev->config;
+	const struct hx711_data *data = dev->data;
+	int ret;
+	int32_t raw_value = 0;
+	uint8_t i;
+
+#ifdef CONFIG_HX711_FAST_READ
+	if (cfg->clock_out != NULL) {
+		return cfg->clock_out(hx711_gain_pulses(data->next_gain), value, high_max);
+	}
+#endif
 
-		/* Clock low */
-		ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 0);
+	/* Read 24 bits of data */
+	for (i = 0; i < 24; i++) {
+		int data_bit;
+
+		ret = hx711_clock_pulse(cfg, &data_bit, high_max);
 		if (ret < 0) {
 			return ret;
 		}
-		k_busy_wait(1);
 
 		/* Shift data into result */
 		raw_value = (raw_value << 1) | data_bit;
 	}
 
-	/* Additional clock pulses to set channel and gain for next reading */
-	/* For 80 SPS: 27 total pulses (24 data + 3 config) = Channel A, Gain 64 */
-	/* For 10 SPS: 25 total pulses (24 data + 1 config) = Channel A, Gain 128 */
-	/* For 10 SPS: 26 total pulses (24 data + 2 config) = Channel B, Gain 32 */
-	
-	/* We want 80 SPS, so we need 3 additional pulses (27 total) */
-	for (i = 0; i < 3; i++) {
-		ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 1);
+	/* Additional clock pulses select channel and gain for the next reading */
+	for (i = 0; i < hx711_gain_pulses(data->next_gain); i++) {
+		ret = hx711_clock_pulse(cfg, NULL, high_max);
 		if (ret < 0) {
 			return ret;
 		}
-		k_busy_wait(1);
+	}
+
+	*value = raw_value;
+	return 0;
+}
+
+#ifdef CONFIG_HX711_FAST_READ
+/*
+ * Frame of one instance whose pins sit on nRF GPIO ports. With the pin
+ * numbers constant the HAL calls below become single OUTSET, OUTCLR and
+ * IN register accesses, and the 24 data pulses are unrolled, so there is
+ * no driver call, no flag check and no return code per edge. The phases
+ * are the same as the generic path's.
+ */
+static ALWAYS_INLINE uint32_t hx711_fast_pulse(uint32_t sck, uint32_t dout, bool sample,
+					       uint32_t *high_max)
+{
+	struct hx711_sck_phase phase;
+	uint32_t bit = 0;
+
+	hx711_phase_begin(&phase);
+	nrf_gpio_pin_set(sck);
+	hx711_phase_high(&phase);
+	if (sample) {
+		bit = nrf_gpio_pin_read(dout);
+	}
+	nrf_gpio_pin_clear(sck);
+	*high_max = MAX(*high_max, hx711_phase_end(&phase));
+
+	return bit;
+}
+
+#define HX711_FAST_BIT(i, sck, dout, high_max)                                      \
+	raw_value = (raw_value << 1) | hx711_fast_pulse(sck, dout, true, high_max)
+
+static ALWAYS_INLINE int hx711_fast_clock_out(uint32_t sck, uint32_t dout, uint8_t pulses,
+					      int32_t *value, uint32_t *high_max)
+{
+	int32_t raw_value = 0;
+
+	LISTIFY(24, HX711_FAST_BIT, (;), sck, dout, high_max);
+
+	switch (pulses) {
+	case 3:
+		(void)hx711_fast_pulse(sck, dout, false, high_max);
+		__fallthrough;
+	case 2:
+		(void)hx711_fast_pulse(sck, dout, false, high_max);
+		__fallthrough;
+	default:
+		(void)hx711_fast_pulse(sck, dout, false, high_max);
+		break;
+	}
+
+	*value = raw_value;
+	return 0;
+}
+#endif /* CONFIG_HX711_FAST_READ */
+
+void hx711_transfer_begin(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+
+#ifdef CONFIG_HX711_TRIGGER
+	hx711_account_read(data);
+
+	/* DOUT toggles with the data bits, keep those edges out of the ISR */
+	hx711_drdy_irq_enable(dev, false);
+#endif
+	HX711_STATS_INC(&data->stats, conversions);
+#ifdef CONFIG_HX711_STATS
+	data->bus_start_cycles = k_cycle_get_32();
+#endif
+}
+
+int hx711_transfer_end(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+
+#ifdef CONFIG_HX711_STATS
+	HX711_STATS_BUS(&data->stats, k_cycle_get_32() - data->bus_start_cycles);
+#else
+	ARG_UNUSED(data);
+#endif
+#ifdef CONFIG_HX711_TRIGGER
+	/* DOUT is high again after the last pulse, rearm for the next edge */
+	k_sem_reset(&data->drdy_sem);
+	if (hx711_drdy_irq_enable(dev, true) < 0) {
+		return -EIO;
+	}
+#endif
+	return 0;
+}
+
+/* One frame, the conversion is not sign extended yet */
+static int hx711_read_frame(const struct device *dev, int32_t *raw_value)
+{
+	struct hx711_data *data = dev->data;
+	uint32_t high_max = 0;
+	bool valid;
+	int ret, err;
 
-		ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 0);
+	/* Wait for data to be ready - use shorter timeout */
+	ret = hx711_wait_for_data(dev, K_MSEC(50));
+	if (ret == -ETIMEDOUT) {
+		HX711_STATS_INC(&data->stats, timeouts);
+	}
+	if (ret < 0) {
+		return ret;
+	}
+
+	hx711_transfer_begin(dev);
+
+#ifdef CONFIG_HX711_SPI
+	if (hx711_uses_spi(dev)) {
+		ret = hx711_spi_clock_out(dev, raw_value);
+	} else {
+		ret = hx711_clock_out(dev, raw_value, &high_max);
+	}
+#else
+	ret = hx711_clock_out(dev, raw_value, &high_max);
+#endif
+
+	err = hx711_transfer_end(dev);
+	if (ret == 0) {
+		ret = err;
+	}
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The frame was clocked out either way, so DOUT rearms */
+	valid = hx711_conversion_done(dev);
+
+	ret = hx711_check_frame(dev, high_max);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return valid ? 0 : -EAGAIN;
+}
+
+int hx711_read_raw(const struct device *dev, int32_t *value)
+{
+	struct hx711_data *data = dev->data;
+	int32_t raw_value = 0;
+	int ret;
+
+	if (!value) {
+		return -EINVAL;
+	}
+
+	/* A stretched frame is dropped and the next conversion read instead */
+	for (uint8_t attempt = 0; ; attempt++) {
+		ret = hx711_read_frame(dev, &raw_value);
+		if (ret != -EBADMSG || attempt == HX711_CLOCK_RETRIES) {
+			break;
+		}
+	}
+	if (ret < 0) {
+		return ret;
+	}
+
+	*value = hx711_sign_extend(raw_value);
+	HX711_STATS_VALUE(&data->stats, *value);
+	return 0;
+}
+
+int hx711_set_rate(const struct device *dev, uint8_t rate_sps)
+{
+	struct hx711_data *data = dev->data;
+	int ret;
+
+	if (rate_sps != 10 && rate_sps != 80) {
+		return -EINVAL;
+	}
+
+	/* While scanning the pin follows the channel, only drive it for channel A */
+	if (!data->scan || data->gain != 32) {
+		ret = hx711_apply_rate(dev, rate_sps);
 		if (ret < 0) {
 			return ret;
 		}
-		k_busy_wait(1);
 	}
 
-	/* Convert to signed 24-bit value */
-	if (raw_value & 0x800000) {
-		raw_value |= 0xFF000000;  /* Sign extend negative values */
+	/* The digital filter restarts, conversions are discarded until it has
+	 * settled at the new rate
+	 */
+	if (rate_sps != data->rate_sps) {
+		data->rate_sps = rate_sps;
+		data->settle = CONFIG_HX711_SETTLE_DISCARD;
+		data->ready_at = sys_timepoint_calc(hx711_settle_time(rate_sps));
+#ifdef CONFIG_HX711_TRIGGER
+		/* Edge spacing changes, the gap is not lost conversions */
+		data->rebase = true;
+#endif
 	}
 
-	*value = raw_value;
 	return 0;
 }
 
-int hx711_set_rate(struct hx711_data *hx711, uint8_t rate_sps)
+int hx711_set_gain(const struct device *dev, uint8_t gain)
 {
-	/* Store the desired rate for next reading */
-	hx711->rate_sps = rate_sps;
-	printk("HX711: Rate set to %d SPS (will be applied on next reading)\n", rate_sps);
+	struct hx711_data *data = dev->data;
+
+	if (!hx711_valid_gain(gain)) {
+		return -EINVAL;
+	}
+
+	if (gain != 32) {
+		data->gain_a = gain;
+	} else if (data->scan) {
+		/* Channel B already gets its turn */
+		return -EBUSY;
+	}
+
+	if (!data->scan) {
+		data->next_gain = gain;
+	} else if (data->next_gain != 32) {
+		data->next_gain = gain;
+	}
+
 	return 0;
 }
 
-int hx711_wait_for_data(struct hx711_data *hx711, k_timeout_t timeout)
+int hx711_set_scan(const struct device *dev, bool enable, uint8_t b_rate_sps)
 {
-	int ret;
-	int64_t start_time = k_uptime_get();
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
+
+	if (!enable) {
+		if (data->scan) {
+			data->scan = false;
+			data->next_gain = data->gain_a;
+			(void)hx711_apply_rate(dev, data->rate_sps);
+		}
+		return 0;
+	}
 
-	if (!hx711 || !hx711->is_initialized) {
+	if (b_rate_sps != 10 && b_rate_sps != 80) {
 		return -EINVAL;
 	}
+	if (cfg->rate.port == NULL && b_rate_sps != data->rate_sps) {
+		return -ENOTSUP;
+	}
+
+	data->scan_b_sps = b_rate_sps;
+	data->scan = true;
+
+	/* Scanning starts from channel A and switches once it has settled */
+	if (data->gain == 32) {
+		data->next_gain = data->gain_a;
+	} else if (data->settle == 0) {
+		data->next_gain = 32;
+	}
+
+	return 0;
+}
+
+uint8_t hx711_last_gain(const struct device *dev)
+{
+	const struct hx711_data *data = dev->data;
+
+	return data->last_gain;
+}
+
+int hx711_wait_for_data(const struct device *dev, k_timeout_t timeout)
+{
+	const struct hx711_config *cfg = dev->config;
+	int ret;
+
+	/* DOUT may already be low if the edge came before we started waiting */
+	ret = gpio_pin_get_dt(&cfg->dout);
+	if (ret <= 0) {
+		return ret;
+	}
+
+#ifdef CONFIG_HX711_TRIGGER
+	struct hx711_data *data = dev->data;
+
+	/* Sleep until the falling edge on DOUT signals data ready */
+	if (k_sem_take(&data->drdy_sem, timeout) < 0) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+#else
+	k_timepoint_t end = sys_timepoint_calc(timeout);
 
 	/* Wait for DOUT to go low (data ready) */
-	while (k_uptime_get() - start_time < timeout.ticks) {
-		ret = gpio_pin_get(hx711->dout_dev, hx711->dout_pin);
+	while (!sys_timepoint_expired(end)) {
+		k_msleep(1);
+		ret = gpio_pin_get_dt(&cfg->dout);
 		if (ret < 0) {
 			return ret;
 		}
 		if (ret == 0) {
 			return 0;  /* Data is ready */
 		}
-		k_msleep(1);
 	}
 
 	return -ETIMEDOUT;
+#endif
 }
 
-int hx711_sleep(struct hx711_data *hx711)
+int hx711_sleep(const struct device *dev)
 {
 	int ret;
 
-	if (!hx711 || !hx711->is_initialized) {
-		return -EINVAL;
+	ret = hx711_power_down(dev);
+	if (ret < 0) {
+		return ret;
 	}
 
-	/* Set SCK high to enter sleep mode */
-	ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 1);
+	return 0;
+}
+
+int hx711_wake_up(const struct device *dev)
+{
+	int ret;
+
+	/* PD_SCK belongs to the SPI controller and idles low */
+	if (hx711_uses_spi(dev)) {
+		return -ENOTSUP;
+	}
+
+	ret = hx711_power_up(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	/* Wait for sleep mode to take effect (>60us required) */
-	k_busy_wait(HX711_SLEEP_DELAY_US);
+	return 0;
+}
+
+k_timeout_t hx711_settle_remaining(const struct device *dev)
+{
+	const struct hx711_data *data = dev->data;
+
+	return sys_timepoint_timeout(data->ready_at);
+}
+
+bool hx711_is_data_ready(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+
+	return gpio_pin_get_dt(&cfg->dout) == 0;  /* Data ready when DOUT is low */
+}
+
+int hx711_array_init(struct hx711_array *array, const struct device *const *sensors,
+		     size_t num_sensors)
+{
+	const struct hx711_config *cfg;
+
+	if (!array || !sensors || num_sensors == 0 ||
+	    num_sensors > CONFIG_HX711_ARRAY_MAX_SENSORS) {
+		return -EINVAL;
+	}
+
+	cfg = sensors[0]->config;
+	array->sck_port = NULL;
+	array->dout_port = cfg->dout.port;
+
+	for (size_t i = 0; i < num_sensors; i++) {
+		if (!device_is_ready(sensors[i])) {
+			return -ENODEV;
+		}
+
+		cfg = sensors[i]->config;
+
+		/* One DOUT port read tells which sensors are ready */
+		if (cfg->dout.port != array->dout_port) {
+			return -ENOTSUP;
+		}
+
+		array->sensors[i] = sensors[i];
+
+		if (hx711_uses_spi(sensors[i])) {
+			continue;
+		}
+
+		/* Lockstep needs one port write per edge and one port read per bit */
+		if (array->sck_port == NULL) {
+			array->sck_port = cfg->sck.port;
+		} else if (cfg->sck.port != array->sck_port) {
+			return -ENOTSUP;
+		}
+
+		/* Port access is raw, so the pins must be active high */
+		if ((cfg->sck.dt_flags & GPIO_ACTIVE_LOW) || (cfg->dout.dt_flags & GPIO_ACTIVE_LOW)) {
+			return -ENOTSUP;
+		}
+	}
+
+	array->num_sensors = num_sensors;
+
+	return 0;
+}
+
+uint32_t hx711_array_ready_mask(struct hx711_array *array)
+{
+	gpio_port_value_t dout;
+	uint32_t mask = 0;
+
+	if (gpio_port_get_raw(array->dout_port, &dout) < 0) {
+		return 0;
+	}
+
+	/* Data ready when DOUT is low */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		const struct hx711_config *cfg = array->sensors[i]->config;
+
+		if (!(dout & BIT(cfg->dout.pin))) {
+			mask |= BIT(i);
+		}
+	}
+
+	return mask;
+}
+
+/* One SCK pulse on sck_pins, the DOUT port is sampled before the falling edge
+ * when sample is not NULL
+ */
+static int hx711_array_pulse(struct hx711_array *array, gpio_port_pins_t sck_pins,
+			     gpio_port_value_t *sample, uint32_t *high_max)
+{
+	struct hx711_sck_phase phase;
+	int ret, err;
+
+	hx711_phase_begin(&phase);
+	ret = gpio_port_set_bits_raw(array->sck_port, sck_pins);
+	hx711_phase_high(&phase);
+	if (ret == 0 && sample != NULL) {
+		ret = gpio_port_get_raw(array->dout_port, sample);
+	}
+	err = gpio_port_clear_bits_raw(array->sck_port, sck_pins);
+	*high_max = MAX(*high_max, hx711_phase_end(&phase));
+
+	return ret < 0 ? ret : err;
+}
+
+static int hx711_array_clock_out(struct hx711_array *array, gpio_port_pins_t sck_pins,
+				 const gpio_port_pins_t *pulse_pins, gpio_port_value_t *samples,
+				 uint32_t *high_max)
+{
+	int ret;
+	uint8_t i;
+
+	/* Every edge drives all SCK pins, every bit is one DOUT port snapshot */
+	for (i = 0; i < 24; i++) {
+		ret = hx711_array_pulse(array, sck_pins, &samples[i], high_max);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	/* Gain pulses, pulse_pins[n] are the sensors that take more than n */
+	for (i = 0; i < 3 && pulse_pins[i] != 0; i++) {
+		ret = hx711_array_pulse(array, pulse_pins[i], NULL, high_max);
+		if (ret < 0) {
+			return ret;
+		}
+	}
 
-	printk("HX711 entered sleep mode\n");
 	return 0;
 }
 
-int hx711_wake_up(struct hx711_data *hx711)
+int hx711_array_read_raw(struct hx711_array *array, uint32_t *mask, int32_t *values)
 {
+	gpio_port_value_t samples[24];
+	gpio_port_pins_t sck_pins = 0;
+	gpio_port_pins_t pulse_pins[3] = {0};
+	uint32_t high_max = 0;
+	uint32_t ready;
 	int ret;
 
-	if (!hx711 || !hx711->is_initialized) {
+	if (!array || !mask || !values) {
 		return -EINVAL;
 	}
 
-	/* Set SCK low to wake up */
-	ret = gpio_pin_set(hx711->sck_dev, hx711->sck_pin, 0);
+	/* Clocking a sensor that is still converting would corrupt its frame */
+	ready = *mask & hx711_array_ready_mask(array);
+	*mask = ready;
+	if (ready == 0) {
+		return 0;
+	}
+
+	/* SPI clocked sensors run their own frame. They go first, so a failed
+	 * one returns before any GPIO member has its data-ready IRQ disabled.
+	 */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		if (!(ready & BIT(i)) || !hx711_uses_spi(array->sensors[i])) {
+			continue;
+		}
+
+		ret = hx711_read_raw(array->sensors[i], &values[i]);
+		if (ret == -EAGAIN) {
+			*mask &= ~BIT(i);
+		} else if (ret < 0) {
+			return ret;
+		}
+		ready &= ~BIT(i);
+	}
+
+	/* The rest share the ports */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		const struct hx711_config *cfg = array->sensors[i]->config;
+		struct hx711_data *data;
+
+		if (!(ready & BIT(i))) {
+			continue;
+		}
+
+		data = array->sensors[i]->data;
+		for (uint8_t p = 0; p < hx711_gain_pulses(data->next_gain); p++) {
+			pulse_pins[p] |= BIT(cfg->sck.pin);
+		}
+
+		sck_pins |= BIT(cfg->sck.pin);
+		hx711_transfer_begin(array->sensors[i]);
+	}
+
+	if (sck_pins == 0) {
+		return 0;
+	}
+
+	ret = hx711_array_clock_out(array, sck_pins, pulse_pins, samples, &high_max);
+
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		if ((ready & BIT(i)) && hx711_transfer_end(array->sensors[i]) < 0 && ret == 0) {
+			ret = -EIO;
+		}
+	}
 	if (ret < 0) {
 		return ret;
 	}
 
-	/* Wait for power up settling time */
-	k_sleep(K_MSEC(400));
+	/* A stretched edge spoils the frame of every member. The gain pulses
+	 * went out all the same, and the next pass reads the next conversion.
+	 */
+	if (hx711_frame_stretched(high_max)) {
+		for (uint8_t i = 0; i < array->num_sensors; i++) {
+			if (ready & BIT(i)) {
+				(void)hx711_conversion_done(array->sensors[i]);
+				(void)hx711_check_frame(array->sensors[i], high_max);
+			}
+		}
+		return -EBADMSG;
+	}
+
+	/* De-interleave the port snapshots into per-sensor 24-bit values */
+	for (uint8_t i = 0; i < array->num_sensors; i++) {
+		const struct hx711_config *cfg = array->sensors[i]->config;
+		struct hx711_data *data = array->sensors[i]->data;
+		gpio_port_pins_t dout_pin = BIT(cfg->dout.pin);
+		int32_t raw_value = 0;
+
+		if (!(ready & BIT(i))) {
+			continue;
+		}
+
+		/* Settling conversions are dropped from the mask */
+		if (!hx711_conversion_done(array->sensors[i])) {
+			*mask &= ~BIT(i);
+			continue;
+		}
+
+		for (uint8_t bit = 0; bit < 24; bit++) {
+			raw_value = (raw_value << 1) | ((samples[bit] & dout_pin) ? 1 : 0);
+		}
+
+		values[i] = hx711_sign_extend(raw_value);
+		HX711_STATS_VALUE(&data->stats, values[i]);
+	}
 
-	printk("HX711 woke up from sleep mode\n");
 	return 0;
 }
 
-bool hx711_is_data_ready(struct hx711_data *hx711)
+static int hx711_sample_fetch(const struct device *dev, enum sensor_channel chan)
 {
-	int ret;
+	struct hx711_data *data = dev->data;
+
+	if (chan != SENSOR_CHAN_ALL && chan != (enum sensor_channel)SENSOR_CHAN_HX711_RAW &&
+	    chan != (enum sensor_channel)SENSOR_CHAN_HX711_LOAD) {
+		return -ENOTSUP;
+	}
+
+	return hx711_read_raw(dev, &data->sample);
+}
+
+static int hx711_channel_get(const struct device *dev, enum sensor_channel chan,
+			     struct sensor_value *val)
+{
+	struct hx711_data *data = dev->data;
+	int32_t milli;
 
-	if (!hx711 || !hx711->is_initialized) {
-		return false;
+	switch ((int)chan) {
+	case SENSOR_CHAN_HX711_RAW:
+		val->val1 = data->sample;
+		val->val2 = 0;
+		return 0;
+	case SENSOR_CHAN_HX711_LOAD:
+		milli = hx711_load(dev, data->sample, data->last_gain);
+		val->val1 = milli / 1000;
+		val->val2 = (milli % 1000) * 1000;
+		return 0;
+	default:
+		return -ENOTSUP;
 	}
+}
+
+static const struct sensor_driver_api hx711_api = {
+	.sample_fetch = hx711_sample_fetch,
+	.channel_get = hx711_channel_get,
+#ifdef CONFIG_HX711_ASYNC
+	.submit = hx711_submit,
+	.get_decoder = hx711_get_decoder,
+#endif
+};
+
+#ifdef CONFIG_HX711_FILTER
+/* Devicetree overrides the Kconfig chain per sensor */
+#define HX711_FILTER_PROP(inst, prop, def) DT_INST_PROP_OR(inst, prop, def)
+
+#define HX711_FILTER_CONFIG(inst)                                                   \
+	.filter = {                                                                 \
+		.median = HX711_FILTER_PROP(inst, filter_median,                    \
+					    CONFIG_HX711_FILTER_MEDIAN),            \
+		.average = HX711_FILTER_PROP(inst, filter_average,                  \
+					     CONFIG_HX711_FILTER_AVERAGE),          \
+		.iir_shift = HX711_FILTER_PROP(inst, filter_iir_shift,              \
+					       CONFIG_HX711_FILTER_IIR_SHIFT),      \
+		.decimate = HX711_FILTER_PROP(inst, filter_decimate,                \
+					      CONFIG_HX711_FILTER_DECIMATE),        \
+		.biquad = DT_INST_NODE_HAS_PROP(inst, filter_biquad),               \
+		.biquad_q14 = DT_INST_PROP_OR(inst, filter_biquad, {0}),            \
+	},
+
+#define HX711_FILTER_CHECK(inst)                                                    \
+	BUILD_ASSERT(HX711_FILTER_PROP(inst, filter_median, CONFIG_HX711_FILTER_MEDIAN) < 3 || \
+		     (HX711_FILTER_PROP(inst, filter_median, CONFIG_HX711_FILTER_MEDIAN) <= \
+		      CONFIG_HX711_FILTER_MEDIAN_MAX &&                             \
+		      HX711_FILTER_PROP(inst, filter_median, CONFIG_HX711_FILTER_MEDIAN) % 2), \
+		     "HX711: median window must be odd and fit HX711_FILTER_MEDIAN_MAX"); \
+	BUILD_ASSERT(HX711_FILTER_PROP(inst, filter_average, CONFIG_HX711_FILTER_AVERAGE) <= \
+		     CONFIG_HX711_FILTER_AVERAGE_MAX,                               \
+		     "HX711: average window must fit HX711_FILTER_AVERAGE_MAX");    \
+	BUILD_ASSERT(DT_INST_PROP_LEN_OR(inst, filter_biquad, 5) == 5,              \
+		     "HX711: filter-biquad takes b0 b1 b2 a1 a2")
+#else
+#define HX711_FILTER_CONFIG(inst)
+#define HX711_FILTER_CHECK(inst) BUILD_ASSERT(1)
+#endif
+
+#define HX711_CONFIG_COMMON(inst)                                                   \
+	.dout = GPIO_DT_SPEC_INST_GET(inst, dout_gpios),                            \
+	.rate = GPIO_DT_SPEC_INST_GET_OR(inst, rate_gpios, {0}),                    \
+	.gain = DT_INST_PROP(inst, gain),                                           \
+	.sps = DT_INST_PROP(inst, sps),                                             \
+	.scan = DT_INST_PROP(inst, channel_b_scan),                                 \
+	.scan_b_sps = DT_INST_PROP(inst, channel_b_sps),                            \
+	.offset = DT_INST_PROP(inst, offset),                                       \
+	HX711_FILTER_CONFIG(inst)                                                   \
+	.scale = DT_INST_PROP(inst, scale)
+
+#define HX711_INST_CHECK(inst)                                                      \
+	HX711_FILTER_CHECK(inst);                                                   \
+	BUILD_ASSERT(!DT_INST_PROP(inst, channel_b_scan) || DT_INST_PROP(inst, gain) != 32, \
+		     "HX711: channel-b-scan needs a channel A gain");              \
+	BUILD_ASSERT(DT_INST_NODE_HAS_PROP(inst, rate_gpios) ||                     \
+		     !DT_INST_PROP(inst, channel_b_scan) ||                         \
+		     DT_INST_PROP(inst, channel_b_sps) == DT_INST_PROP(inst, sps),  \
+		     "HX711: channel-b-sps needs rate-gpios")
+
+#define DT_DRV_COMPAT avia_hx711
+
+#ifdef CONFIG_HX711_FAST_READ
+/* Absolute nRF pin number, port * 32 + pin */
+#define HX711_FAST_PSEL(inst, prop)                                                 \
+	(DT_INST_GPIO_PIN(inst, prop) +                                             \
+	 (DT_PROP_BY_PHANDLE_IDX_OR(DT_DRV_INST(inst), prop, 0, port, 0) << 5))
+
+/* Active-high pins on an nRF GPIO port, the rest take the generic path */
+#define HX711_FAST_PIN_OK(inst, prop)                                               \
+	(DT_NODE_HAS_COMPAT(DT_INST_GPIO_CTLR(inst, prop), nordic_nrf_gpio) &&      \
+	 !(DT_INST_GPIO_FLAGS(inst, prop) & GPIO_ACTIVE_LOW))
+
+#define HX711_FAST_DEFINE(inst)                                                     \
+	static int hx711_fast_clock_out_##inst(uint8_t pulses, int32_t *value,      \
+					       uint32_t *high_max)                  \
+	{                                                                           \
+		return hx711_fast_clock_out(HX711_FAST_PSEL(inst, sck_gpios),       \
+					    HX711_FAST_PSEL(inst, dout_gpios),      \
+					    pulses, value, high_max);               \
+	}
+
+#define HX711_FAST_CONFIG(inst)                                                     \
+	.clock_out = (HX711_FAST_PIN_OK(inst, sck_gpios) &&                         \
+		      HX711_FAST_PIN_OK(inst, dout_gpios)) ?                        \
+		     hx711_fast_clock_out_##inst : NULL,
+#else
+#define HX711_FAST_DEFINE(inst)
+#define HX711_FAST_CONFIG(inst)
+#endif
+
+#define HX711_GPIO_DEFINE(inst)                                                     \
+	HX711_INST_CHECK(inst);                                                     \
+	HX711_FAST_DEFINE(inst)                                                     \
+	static struct hx711_data hx711_data_##inst;                                 \
+	static const struct hx711_config hx711_config_##inst = {                    \
+		HX711_CONFIG_COMMON(inst),                                          \
+		HX711_FAST_CONFIG(inst)                                             \
+		.sck = GPIO_DT_SPEC_INST_GET(inst, sck_gpios),                      \
+	};                                                                          \
+	PM_DEVICE_DT_INST_DEFINE(inst, hx711_pm_action);                            \
+	SENSOR_DEVICE_DT_INST_DEFINE(inst, hx711_init, PM_DEVICE_DT_INST_GET(inst), \
+				     &hx711_data_##inst,                            \
+				     &hx711_config_##inst, POST_KERNEL,             \
+				     CONFIG_SENSOR_INIT_PRIORITY, &hx711_api);
+
+DT_INST_FOREACH_STATUS_OKAY(HX711_GPIO_DEFINE)
+
+#undef DT_DRV_COMPAT
+
+#ifdef CONFIG_HX711_SPI
+#define DT_DRV_COMPAT avia_hx711_spi
+
+#define HX711_SPI_DEFINE(inst)                                                      \
+	HX711_INST_CHECK(inst);                                                     \
+	static struct hx711_data hx711_spi_data_##inst;                             \
+	static const struct hx711_config hx711_spi_config_##inst = {                \
+		HX711_CONFIG_COMMON(inst),                                          \
+		.spi = SPI_DT_SPEC_INST_GET(inst, HX711_SPI_OPERATION, 0),          \
+		.use_spi = true,                                                    \
+	};                                                                          \
+	PM_DEVICE_DT_INST_DEFINE(inst, hx711_pm_action);                            \
+	SENSOR_DEVICE_DT_INST_DEFINE(inst, hx711_init, PM_DEVICE_DT_INST_GET(inst), \
+				     &hx711_spi_data_##inst,                        \
+				     &hx711_spi_config_##inst, POST_KERNEL,         \
+				     CONFIG_SENSOR_INIT_PRIORITY, &hx711_api);
+
+DT_INST_FOREACH_STATUS_OKAY(HX711_SPI_DEFINE)
 
-	ret = gpio_pin_get(hx711->dout_dev, hx711->dout_pin);
-	return (ret == 0);  /* Data ready when DOUT is low */
-} 
\ No newline at end of file
+#undef DT_DRV_COMPAT
+#endif /* CONFIG_HX711_SPI */
@@ -8,39 +8,206 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
 #include <zephyr/device.h>
+#include <zephyr/devicetree.h>
 #include "hx711_config.h"
+#include "hx711_core.h"
+#include "hx711_calib.h"
+#include "hx711_stats.h"
+#ifdef CONFIG_HX711_FILTER
+#include "hx711_filter.h"
+#endif
+#ifdef CONFIG_HX711_SPI
+#include <zephyr/drivers/spi.h>
+#endif
+#ifdef CONFIG_HX711_ASYNC
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* HX711 data structure */
+/* HX711 specific sensor channels */
+enum hx711_sensor_channel {
+	/* Signed 24-bit conversion, val1 only */
+	SENSOR_CHAN_HX711_RAW = SENSOR_CHAN_PRIV_START,
+	/* Calibrated load in the unit the calibration was made in */
+	SENSOR_CHAN_HX711_LOAD,
+};
+
+/* Every enabled HX711 in devicetree order, GPIO sensors then SPI sensors */
+#define HX711_DEVICE_DT_GET_COMMA(node_id) DEVICE_DT_GET(node_id),
+#define HX711_DT_DEVICES                                                            \
+	DT_FOREACH_STATUS_OKAY(avia_hx711, HX711_DEVICE_DT_GET_COMMA)              \
+	DT_FOREACH_STATUS_OKAY(avia_hx711_spi, HX711_DEVICE_DT_GET_COMMA)
+
+#ifdef CONFIG_HX711_SPI
+/* 24 data + up to 3 gain pulses, two MOSI bits per PD_SCK pulse */
+#define HX711_SPI_FRAME_LEN 7
+
+typedef void (*hx711_spi_callback_t)(const struct device *dev, int result, int32_t value,
+				     void *user_data);
+#endif
+
+#ifdef CONFIG_HX711_ASYNC
+/* RTIO buffer written per conversion, turned into q31 by the decoder */
+struct hx711_encoded_data {
+	uint64_t timestamp_ns; /* Data-ready edge, uptime in ns */
+	int32_t raw;           /* Sign-extended 24-bit conversion */
+	int32_t load_milli;    /* Calibrated at the time of the read */
+	bool has_sample;       /* False for SENSOR_STREAM_DATA_NOP/DROP */
+	bool drdy;             /* Produced by the data-ready stream trigger */
+};
+#endif
+
+#ifdef CONFIG_HX711_FAST_READ
+/* Frame of one instance with its pins built in, then pulses gain pulses */
+typedef int (*hx711_clock_out_t)(uint8_t pulses, int32_t *value, uint32_t *high_max);
+#endif
+
+/* HX711 configuration, resolved from devicetree at build time */
+struct hx711_config {
+	struct gpio_dt_spec dout;
+	struct gpio_dt_spec sck;  /* Not used with the SPI transport */
+#ifdef CONFIG_HX711_FAST_READ
+	hx711_clock_out_t clock_out; /* NULL where the generic GPIO path is used */
+#endif
+	struct gpio_dt_spec rate; /* Optional, port is NULL when not wired */
+#ifdef CONFIG_HX711_SPI
+	struct spi_dt_spec spi;
+	bool use_spi;
+#endif
+	uint8_t gain;             /* Initial gain, 32 selects channel B */
+	uint8_t sps;              /* Initial rate, the strapped one without RATE */
+	bool scan;                /* Start in channel A/B scan mode */
+	uint8_t scan_b_sps;       /* Channel B rate while scanning */
+	int32_t offset;           /* Initial calibration, raw count at zero load */
+	int32_t scale;            /* Initial calibration, micro-units per count */
+#ifdef CONFIG_HX711_FILTER
+	struct hx711_filter_config filter; /* Applied by the acquisition thread */
+#endif
+};
+
+/* HX711 runtime data */
 struct hx711_data {
-	const struct device *dout_dev;
-	const struct device *sck_dev;
-	gpio_pin_t dout_pin;
-	gpio_pin_t sck_pin;
-	gpio_flags_t dout_flags;
-	gpio_flags_t sck_flags;
-	bool is_initialized;
-	uint8_t rate_sps;  /* Desired sampling rate in SPS */
+	const struct device *dev;
+	uint8_t rate_sps;  /* Sampling rate of channel A, or of the only channel */
+	int32_t sample;    /* Last fetched conversion */
+	/* Gain and channel, 128 and 64 are channel A, 32 is channel B */
+	uint8_t gain;        /* Of the conversion in progress */
+	uint8_t next_gain;   /* Selected by the pulses of the next read */
+	uint8_t last_gain;   /* Of the conversion returned last */
+	uint8_t gain_a;      /* Channel A gain to return to while scanning */
+	uint8_t settle;      /* Conversions still to discard after a switch */
+	bool scan;           /* Alternate channel A and B */
+	uint8_t scan_b_sps;  /* Channel B rate while scanning */
+	k_timepoint_t ready_at;    /* Output settled after power up or resume */
+	struct hx711_calib calib;  /* Under calib_lock, see hx711_calib_get() */
+	struct k_spinlock calib_lock;
+	bool calib_restored;       /* Calibration was loaded from settings */
+#ifdef CONFIG_HX711_TRIGGER
+	struct gpio_callback dout_cb;
+	struct k_sem drdy_sem;       /* Given on every DOUT falling edge */
+	uint32_t drdy_cycles;        /* Cycle count of the last data-ready edge */
+	uint32_t last_read_cycles;   /* Data-ready edge of the previous read */
+	bool rebase;                 /* No previous read, or powered down since */
+#endif
+	struct hx711_stats stats;    /* Empty without CONFIG_HX711_STATS */
+#ifdef CONFIG_HX711_STATS
+	uint32_t bus_start_cycles;   /* Start of the frame being clocked out */
+#endif
+#ifdef CONFIG_HX711_SPI
+	uint8_t spi_rx[HX711_SPI_FRAME_LEN];
+#ifdef CONFIG_SPI_ASYNC
+	struct spi_buf spi_tx_buf;
+	struct spi_buf_set spi_tx_set;
+	struct spi_buf spi_rx_buf;
+	struct spi_buf_set spi_rx_set;
+	hx711_spi_callback_t spi_cb;
+	void *spi_cb_data;
+#endif
+#endif
+#ifdef CONFIG_HX711_ASYNC
+	struct k_work rtio_work;
+	atomic_ptr_t rtio_sqe;       /* Submission waiting for data-ready */
+#endif
+};
+
+/* Sensors sharing one SCK port and one DOUT port, clocked in lockstep */
+struct hx711_array {
+	const struct device *sensors[CONFIG_HX711_ARRAY_MAX_SENSORS];
+	uint8_t num_sensors;
+	const struct device *sck_port;
+	const struct device *dout_port;
 };
 
 /* Function prototypes */
-int hx711_init(struct hx711_data *hx711, 
-               const struct device *dout_dev, gpio_pin_t dout_pin, gpio_flags_t dout_flags,
-               const struct device *sck_dev, gpio_pin_t sck_pin, gpio_flags_t sck_flags);
+int hx711_read_raw(const struct device *dev, int32_t *value);
+int hx711_wait_for_data(const struct device *dev, k_timeout_t timeout);
+/* Direct power control, use pm_device_runtime_get/put() instead when runtime
+ * PM is enabled on the device. Waking up does not block, conversions are
+ * discarded until the output has settled.
+ */
+int hx711_sleep(const struct device *dev);
+int hx711_wake_up(const struct device *dev);
+
+/* Time left until conversions are valid after init or resume */
+k_timeout_t hx711_settle_remaining(const struct device *dev);
+int hx711_set_rate(const struct device *dev, uint8_t rate_sps);
+bool hx711_is_data_ready(const struct device *dev);
+
+/* 128 or 64 for channel A, 32 for channel B, applied by the next read */
+int hx711_set_gain(const struct device *dev, uint8_t gain);
+
+/* Alternate channel A and B, reads of settling conversions fail with -EAGAIN */
+int hx711_set_scan(const struct device *dev, bool enable, uint8_t b_rate_sps);
 
-int hx711_read_raw(struct hx711_data *hx711, int32_t *value);
-int hx711_wait_for_data(struct hx711_data *hx711, k_timeout_t timeout);
-int hx711_sleep(struct hx711_data *hx711);
-int hx711_wake_up(struct hx711_data *hx711);
-int hx711_set_rate(struct hx711_data *hx711, uint8_t rate_sps);
-bool hx711_is_data_ready(struct hx711_data *hx711);
+/* Gain of the conversion returned by the last successful read */
+uint8_t hx711_last_gain(const struct device *dev);
+
+#if defined(CONFIG_HX711_SPI) && defined(CONFIG_SPI_ASYNC)
+int hx711_spi_read_async(const struct device *dev, hx711_spi_callback_t cb, void *user_data);
+#endif
+
+/* Lockstep multi-sensor access, bit n of a mask is array->sensors[n] */
+int hx711_array_init(struct hx711_array *array, const struct device *const *sensors,
+		     size_t num_sensors);
+uint32_t hx711_array_ready_mask(struct hx711_array *array);
+int hx711_array_read_raw(struct hx711_array *array, uint32_t *mask, int32_t *values);
+
+/* Pulses after the 24 data bits: 25 -> A/128, 26 -> B/32, 27 -> A/64 */
+static inline uint8_t hx711_gain_pulses(uint8_t gain)
+{
+	switch (gain) {
+	case 128:
+		return 1;
+	case 32:
+		return 2;
+	default:
+		return 3;
+	}
+}
+
+#ifdef CONFIG_HX711_ASYNC
+/* Sensor read-and-decode API, see hx711_async.c and hx711_decoder.c */
+void hx711_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+int hx711_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+void hx711_async_init(const struct device *dev);
+void hx711_async_drdy(struct hx711_data *data);
+#endif
+
+/* Transport internals shared by the driver sources */
+void hx711_transfer_begin(const struct device *dev);
+int hx711_transfer_end(const struct device *dev);
+bool hx711_conversion_done(const struct device *dev);
+#ifdef CONFIG_HX711_SPI
+int hx711_spi_clock_out(const struct device *dev, int32_t *value);
+#endif
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* HX711_DRIVER_H_ */ 
\ No newline at end of file
+#endif /* HX711_DRIVER_H_ */
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_emul.h"
+#include "hx711_config.h"
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#if defined(CONFIG_HX711_SPI) && defined(CONFIG_SPI_EMUL)
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#endif
+#include <zephyr/init.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+/* gpio_emul calls the port callbacks whenever an output-only pin is
+ * written, which is where PD_SCK is watched. DOUT is driven through the
+ * emulated input, so the driver's data-ready interrupt fires as on
+ * hardware. The model follows the datasheet: data is shifted out on the
+ * rising edge, pulses 25..27 select the next gain, DOUT goes high after
+ * the 25th pulse, and SCK high for more than 60 us powers the chip down
+ * until the next falling edge, after which it settles before the first
+ * conversion.
+ *
+ * An "avia,hx711-spi" node under a zephyr,spi-emul-controller runs the
+ * same model from the SPI frame instead: every MOSI bit is the PD_SCK
+ * level for one bit time and MISO returns DOUT as it stands after that
+ * bit, which is the pin the driver also watches for data-ready.
+ */
+
+#define HX711_EMUL_SLEEP_US 60
+#define HX711_EMUL_MAX      0x7FFFFF
+#define HX711_EMUL_MIN      (-0x800000)
+
+struct hx711_emul {
+	const struct device *dev;
+	struct gpio_dt_spec dout;
+	struct gpio_dt_spec sck;   /* Not set when SPI clocks the frame */
+	struct gpio_dt_spec rate;
+	uint8_t sps;           /* Strapped rate when RATE is not wired */
+	struct gpio_callback sck_cb;
+	struct k_timer timer;
+	struct k_spinlock lock;
+
+	/* Waveform */
+	hx711_emul_source_t source;
+	void *user_data;
+	int32_t ramp_base;
+	int32_t ramp_step;
+	const int32_t *script;
+	size_t script_len;
+	bool script_loop;
+
+	/* Chip state */
+	uint32_t n;            /* Conversions produced so far */
+	int32_t value;         /* Conversion being shifted out */
+	bool ready;            /* DOUT low, conversion unread */
+	uint8_t dout_raw;      /* Physical DOUT level, what MISO samples */
+	uint8_t pulses;        /* PD_SCK pulses of the current read */
+	uint8_t gain_pulses;   /* Pulse count that set the current gain */
+	bool sck_high;
+	uint32_t sck_rise_cycles;
+	bool sleeping;
+
+	struct hx711_emul_stats stats;
+};
+
+#define HX711_EMUL_NAME(node_id) _CONCAT(hx711_emul_, DT_DEP_ORD(node_id))
+
+#define HX711_EMUL_DEFINE(node_id)                                                  \
+	static struct hx711_emul HX711_EMUL_NAME(node_id) = {                       \
+		.dev = DEVICE_DT_GET(node_id),                                      \
+		.dout = GPIO_DT_SPEC_GET(node_id, dout_gpios),                      \
+		.sck = GPIO_DT_SPEC_GET_OR(node_id, sck_gpios, {0}),                \
+		.rate = GPIO_DT_SPEC_GET_OR(node_id, rate_gpios, {0}),              \
+		.sps = DT_PROP(node_id, sps),                                       \
+	};
+
+#define HX711_EMUL_REF(node_id) &HX711_EMUL_NAME(node_id),
+
+DT_FOREACH_STATUS_OKAY(avia_hx711, HX711_EMUL_DEFINE)
+#if defined(CONFIG_HX711_SPI) && defined(CONFIG_SPI_EMUL)
+DT_FOREACH_STATUS_OKAY(avia_hx711_spi, HX711_EMUL_DEFINE)
+#endif
+
+static struct hx711_emul *const hx711_emuls[] = {
+	DT_FOREACH_STATUS_OKAY(avia_hx711, HX711_EMUL_REF)
+#if defined(CONFIG_HX711_SPI) && defined(CONFIG_SPI_EMUL)
+	DT_FOREACH_STATUS_OKAY(avia_hx711_spi, HX711_EMUL_REF)
+#endif
+};
+
+static struct hx711_emul *hx711_emul_find(const struct device *dev)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_emuls); i++) {
+		if (hx711_emuls[i]->dev == dev) {
+			return hx711_emuls[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int hx711_emul_level(const struct gpio_dt_spec *spec)
+{
+	gpio_port_value_t values = 0;
+
+	gpio_emul_output_get_masked(spec->port, BIT(spec->pin), &values);
+
+	return ((values & BIT(spec->pin)) != 0) ^ ((spec->dt_flags & GPIO_ACTIVE_LOW) != 0);
+}
+
+static void hx711_emul_dout_set(struct hx711_emul *emul, int level)
+{
+	emul->dout_raw = level ^ ((emul->dout.dt_flags & GPIO_ACTIVE_LOW) != 0);
+	gpio_emul_input_set(emul->dout.port, emul->dout.pin, emul->dout_raw);
+}
+
+/* RATE high selects 80 SPS, a board without the line is strapped */
+static uint32_t hx711_emul_sps(struct hx711_emul *emul)
+{
+	if (emul->rate.port == NULL) {
+		return emul->sps;
+	}
+
+	return hx711_emul_level(&emul->rate) ? 80 : 10;
+}
+
+static k_timeout_t hx711_emul_period(struct hx711_emul *emul)
+{
+	return K_USEC(USEC_PER_SEC / hx711_emul_sps(emul));
+}
+
+/* Output settling time after power up or reset */
+static k_timeout_t hx711_emul_settle(struct hx711_emul *emul)
+{
+	return hx711_emul_sps(emul) == 80 ? K_MSEC(50) : K_MSEC(400);
+}
+
+static int32_t hx711_emul_next(struct hx711_emul *emul)
+{
+	int32_t value;
+
+	if (emul->source != NULL) {
+		value = emul->source(emul->dev, emul->n, emul->user_data);
+	} else if (emul->script != NULL) {
+		size_t i = emul->script_loop ? emul->n % emul->script_len :
+					       MIN(emul->n, emul->script_len - 1);
+
+		value = emul->script[i];
+	} else {
+		value = (int32_t)((int64_t)emul->ramp_base + (int64_t)emul->ramp_step * emul->n);
+	}
+
+	/* The ADC output saturates at the 24-bit limits */
+	return CLAMP(value, HX711_EMUL_MIN, HX711_EMUL_MAX);
+}
+
+static void hx711_emul_conversion(struct k_timer *timer)
+{
+	struct hx711_emul *emul = CONTAINER_OF(timer, struct hx711_emul, timer);
+	k_spinlock_key_t key = k_spin_lock(&emul->lock);
+
+	/* Powered down, the falling edge on SCK restarts the timer */
+	if (emul->sck_high &&
+	    k_cyc_to_us_floor32(k_cycle_get_32() - emul->sck_rise_cycles) > HX711_EMUL_SLEEP_US) {
+		if (!emul->sleeping) {
+			emul->sleeping = true;
+			emul->stats.sleeps++;
+		}
+		k_spin_unlock(&emul->lock, key);
+		return;
+	}
+
+	if (emul->pulses > 0 && emul->pulses < 25) {
+		/* Data register is busy shifting, this conversion is lost */
+		emul->stats.collisions++;
+	} else {
+		if (emul->ready) {
+			emul->stats.overwritten++;
+		}
+		emul->pulses = 0;
+		emul->value = hx711_emul_next(emul);
+		emul->n++;
+		emul->stats.conversions++;
+
+		/* DOUT already low when unread, so no new edge in that case */
+		emul->ready = true;
+		hx711_emul_dout_set(emul, 0);
+	}
+
+	k_timer_start(&emul->timer, hx711_emul_period(emul), K_NO_WAIT);
+	k_spin_unlock(&emul->lock, key);
+}
+
+static void hx711_emul_sck_rising(struct hx711_emul *emul)
+{
+	emul->sck_rise_cycles = k_cycle_get_32();
+
+	/* Pulses without data ready do not start a read */
+	if (!emul->ready && emul->pulses == 0) {
+		return;
+	}
+
+	emul->pulses++;
+	if (emul->pulses <= 24) {
+		/* MSB first, valid while SCK is high */
+		hx711_emul_dout_set(emul, (emul->value >> (24 - emul->pulses)) & 1);
+		return;
+	}
+
+	if (emul->pulses == 25) {
+		emul->ready = false;
+		emul->stats.reads++;
+		hx711_emul_dout_set(emul, 1);
+	}
+
+	if (emul->pulses <= 27) {
+		emul->gain_pulses = emul->pulses;
+	}
+}
+
+static void hx711_emul_sck_falling(struct hx711_emul *emul)
+{
+	uint32_t high_us = k_cyc_to_us_floor32(k_cycle_get_32() - emul->sck_rise_cycles);
+
+	if (high_us <= HX711_EMUL_SLEEP_US) {
+		return;
+	}
+
+	/* Wake up from power down: reset to channel A, gain 128 */
+	if (!emul->sleeping) {
+		emul->stats.sleeps++;
+	}
+	emul->sleeping = false;
+	emul->ready = false;
+	emul->pulses = 0;
+	emul->gain_pulses = 25;
+	hx711_emul_dout_set(emul, 1);
+	k_timer_start(&emul->timer, hx711_emul_settle(emul), K_NO_WAIT);
+}
+
+/* Called with the lock held, a level equal to the current one is no edge */
+static void hx711_emul_sck_set(struct hx711_emul *emul, bool high)
+{
+	if (high == emul->sck_high) {
+		return;
+	}
+
+	emul->sck_high = high;
+	if (high) {
+		hx711_emul_sck_rising(emul);
+	} else {
+		hx711_emul_sck_falling(emul);
+	}
+}
+
+static void hx711_emul_sck_changed(const struct device *port, struct gpio_callback *cb,
+				   gpio_port_pins_t pins)
+{
+	struct hx711_emul *emul = CONTAINER_OF(cb, struct hx711_emul, sck_cb);
+	k_spinlock_key_t key;
+	bool high;
+
+	ARG_UNUSED(port);
+	ARG_UNUSED(pins);
+
+	/* Called for any output write on the port, keep only SCK edges */
+	high = hx711_emul_level(&emul->sck);
+
+	key = k_spin_lock(&emul->lock);
+	hx711_emul_sck_set(emul, high);
+	k_spin_unlock(&emul->lock, key);
+}
+
+#if defined(CONFIG_HX711_SPI) && defined(CONFIG_SPI_EMUL)
+/* Store the next MISO byte, rx buffers without memory are clocked but dropped */
+static void hx711_emul_spi_rx(const struct spi_buf_set *rx_bufs, size_t *buf, size_t *pos,
+			      uint8_t byte)
+{
+	while (rx_bufs != NULL && *buf < rx_bufs->count) {
+		const struct spi_buf *rx = &rx_bufs->buffers[*buf];
+
+		if (*pos < rx->len) {
+			if (rx->buf != NULL) {
+				((uint8_t *)rx->buf)[*pos] = byte;
+			}
+			(*pos)++;
+			return;
+		}
+		(*buf)++;
+		*pos = 0;
+	}
+}
+
+/* MSB first, MOSI is PD_SCK and MISO is DOUT */
+static int hx711_emul_spi_io(const struct emul *target, const struct spi_config *config,
+			     const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+	struct hx711_emul *emul = target->data;
+	size_t rx_buf = 0;
+	size_t rx_pos = 0;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(config);
+
+	if (tx_bufs == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	for (size_t b = 0; b < tx_bufs->count; b++) {
+		const struct spi_buf *tx = &tx_bufs->buffers[b];
+
+		for (size_t i = 0; i < tx->len; i++) {
+			uint8_t mosi = tx->buf != NULL ? ((const uint8_t *)tx->buf)[i] : 0;
+			uint8_t miso = 0;
+
+			for (int bit = 7; bit >= 0; bit--) {
+				hx711_emul_sck_set(emul, (mosi >> bit) & 1);
+				miso |= emul->dout_raw << bit;
+			}
+			hx711_emul_spi_rx(rx_bufs, &rx_buf, &rx_pos, miso);
+		}
+	}
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+static const struct spi_emul_api hx711_emul_spi_api = {
+	.io = hx711_emul_spi_io,
+};
+
+/* The model starts with the others in hx711_emul_init() */
+static int hx711_emul_spi_init(const struct emul *target, const struct device *parent)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(parent);
+
+	return 0;
+}
+
+#define HX711_EMUL_SPI_DEFINE(node_id)                                              \
+	EMUL_DT_DEFINE(node_id, hx711_emul_spi_init, &HX711_EMUL_NAME(node_id), NULL, \
+		       &hx711_emul_spi_api, NULL);
+
+DT_FOREACH_STATUS_OKAY(avia_hx711_spi, HX711_EMUL_SPI_DEFINE)
+#endif /* CONFIG_HX711_SPI && CONFIG_SPI_EMUL */
+
+int hx711_emul_set_ramp(const struct device *dev, int32_t base, int32_t step)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+	k_spinlock_key_t key;
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	emul->source = NULL;
+	emul->script = NULL;
+	emul->ramp_base = base;
+	emul->ramp_step = step;
+	emul->n = 0;
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+int hx711_emul_set_script(const struct device *dev, const int32_t *samples, size_t count,
+			  bool loop)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+	k_spinlock_key_t key;
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+	if (samples == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	emul->source = NULL;
+	emul->script = samples;
+	emul->script_len = count;
+	emul->script_loop = loop;
+	emul->n = 0;
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+int hx711_emul_set_source(const struct device *dev, hx711_emul_source_t source,
+			  void *user_data)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+	k_spinlock_key_t key;
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	emul->source = source;
+	emul->user_data = user_data;
+	emul->n = 0;
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+int hx711_emul_gain(const struct device *dev)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+
+	switch (emul->gain_pulses) {
+	case 26:
+		return 32;
+	case 27:
+		return 64;
+	default:
+		return 128;
+	}
+}
+
+bool hx711_emul_is_sleeping(const struct device *dev)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+
+	return emul != NULL && emul->sleeping;
+}
+
+int hx711_emul_get_stats(const struct device *dev, struct hx711_emul_stats *stats)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+	k_spinlock_key_t key;
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	*stats = emul->stats;
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+int hx711_emul_reset_stats(const struct device *dev)
+{
+	struct hx711_emul *emul = hx711_emul_find(dev);
+	k_spinlock_key_t key;
+
+	if (emul == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&emul->lock);
+	emul->stats = (struct hx711_emul_stats){0};
+	k_spin_unlock(&emul->lock, key);
+
+	return 0;
+}
+
+static int hx711_emul_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_emuls); i++) {
+		struct hx711_emul *emul = hx711_emuls[i];
+		int ret;
+
+		/* Distinct default ramps so channels can be told apart */
+		emul->ramp_base = (int32_t)i * 100000;
+		emul->ramp_step = 16;
+		emul->gain_pulses = 25;
+
+		/* DOUT idles high until the first conversion */
+		hx711_emul_dout_set(emul, 1);
+
+		/* SPI clocked models are driven from hx711_emul_spi_io() */
+		if (emul->sck.port != NULL) {
+			gpio_init_callback(&emul->sck_cb, hx711_emul_sck_changed,
+					   BIT(emul->sck.pin));
+			ret = gpio_add_callback_dt(&emul->sck, &emul->sck_cb);
+			if (ret < 0) {
+				printk("HX711 emulator %u: failed to watch SCK: %d\n",
+				       (unsigned int)i, ret);
+				return ret;
+			}
+		}
+
+		k_timer_init(&emul->timer, hx711_emul_conversion, NULL);
+		k_timer_start(&emul->timer, hx711_emul_settle(emul), K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+/* After the sensor drivers, gpio_emul only drives pins configured as inputs */
+SYS_INIT(hx711_emul_init, POST_KERNEL, CONFIG_HX711_EMUL_INIT_PRIORITY);
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_EMUL_H_
+#define HX711_EMUL_H_
+
+#include <zephyr/device.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Behavioural HX711 model on gpio_emul pins, one per "avia,hx711" node,
+ * and on a zephyr,spi-emul-controller for "avia,hx711-spi" nodes. All
+ * functions take the sensor device the emulator is attached to.
+ */
+
+/* Returns the 24-bit conversion number n, called from the conversion timer */
+typedef int32_t (*hx711_emul_source_t)(const struct device *dev, uint32_t n, void *user_data);
+
+/* Model state and counters */
+struct hx711_emul_stats {
+	uint32_t conversions;  /* Conversions made ready */
+	uint32_t reads;        /* Conversions clocked out completely */
+	uint32_t overwritten;  /* Conversions replaced before being read */
+	uint32_t collisions;   /* Conversions skipped because a read was in progress */
+	uint32_t sleeps;       /* Power downs, SCK held high > 60 us */
+};
+
+/* Synthetic waveform, a ramp of step counts per conversion from base */
+int hx711_emul_set_ramp(const struct device *dev, int32_t base, int32_t step);
+
+/* Play back samples, wrapping when loop is set and holding the last one otherwise */
+int hx711_emul_set_script(const struct device *dev, const int32_t *samples, size_t count,
+			  bool loop);
+
+/* Any other waveform */
+int hx711_emul_set_source(const struct device *dev, hx711_emul_source_t source,
+			  void *user_data);
+
+/* Gain selected by the pulse count of the last read: 128, 64 or 32 */
+int hx711_emul_gain(const struct device *dev);
+
+bool hx711_emul_is_sleeping(const struct device *dev);
+int hx711_emul_get_stats(const struct device *dev, struct hx711_emul_stats *stats);
+int hx711_emul_reset_stats(const struct device *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_EMUL_H_ */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_filter.h"
+#include "hx711_core.h"
+#include <string.h>
+
+void hx711_filter_init(struct hx711_filter *filter, const struct hx711_filter_config *cfg)
+{
+	filter->cfg = cfg;
+	hx711_filter_reset(filter);
+}
+
+void hx711_filter_reset(struct hx711_filter *filter)
+{
+	const struct hx711_filter_config *cfg = filter->cfg;
+
+	memset(filter, 0, sizeof(*filter));
+	filter->cfg = cfg;
+}
+
+/* Median of the samples seen so far, up to the window size */
+static int32_t hx711_filter_median(struct hx711_filter *filter, int32_t in)
+{
+	uint8_t window = filter->cfg->median;
+	int32_t sorted[CONFIG_HX711_FILTER_MEDIAN_MAX];
+	uint8_t n;
+
+	filter->median_buf[filter->median_pos] = in;
+	filter->median_pos = (filter->median_pos + 1) % window;
+	if (filter->median_fill < window) {
+		filter->median_fill++;
+	}
+	n = filter->median_fill;
+
+	/* Insertion sort, the window is a handful of samples */
+	for (uint8_t i = 0; i < n; i++) {
+		int32_t v = filter->median_buf[i];
+		uint8_t j = i;
+
+		while (j > 0 && sorted[j - 1] > v) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = v;
+	}
+
+	return sorted[n / 2];
+}
+
+/* Running sum, one add and one subtract per sample */
+static int32_t hx711_filter_average(struct hx711_filter *filter, int32_t in)
+{
+	uint8_t window = filter->cfg->average;
+
+	if (filter->average_fill == window) {
+		filter->average_sum -= filter->average_buf[filter->average_pos];
+	} else {
+		filter->average_fill++;
+	}
+
+	filter->average_buf[filter->average_pos] = in;
+	filter->average_sum += in;
+	filter->average_pos = (filter->average_pos + 1) % window;
+
+	return filter->average_sum / filter->average_fill;
+}
+
+static int32_t hx711_filter_iir(struct hx711_filter *filter, int32_t in)
+{
+	uint8_t shift = filter->cfg->iir_shift;
+
+	if (!filter->primed) {
+		filter->iir_acc = (int64_t)in << shift;
+	} else {
+		filter->iir_acc += in - (filter->iir_acc >> shift);
+	}
+
+	return (int32_t)(filter->iir_acc >> shift);
+}
+
+/* Direct form I, states start at the first input so there is no step at start */
+static int32_t hx711_filter_biquad(struct hx711_filter *filter, int32_t in)
+{
+	const int32_t *c = filter->cfg->biquad_q14;
+	int64_t acc;
+	int32_t out;
+
+	if (!filter->primed) {
+		filter->bq_x[0] = filter->bq_x[1] = in;
+		filter->bq_y[0] = filter->bq_y[1] = in;
+	}
+
+	acc = (int64_t)c[0] * in + (int64_t)c[1] * filter->bq_x[0] +
+	      (int64_t)c[2] * filter->bq_x[1] - (int64_t)c[3] * filter->bq_y[0] -
+	      (int64_t)c[4] * filter->bq_y[1];
+	out = hx711_clamp_s32(acc >> HX711_FILTER_BIQUAD_Q, INT32_MIN, INT32_MAX);
+
+	filter->bq_x[1] = filter->bq_x[0];
+	filter->bq_x[0] = in;
+	filter->bq_y[1] = filter->bq_y[0];
+	filter->bq_y[0] = out;
+
+	return out;
+}
+
+bool hx711_filter_run(struct hx711_filter *filter, int32_t in, int32_t *out)
+{
+	const struct hx711_filter_config *cfg = filter->cfg;
+	int32_t v = in;
+
+	if (cfg == NULL) {
+		filter->value = in;
+		*out = in;
+		return true;
+	}
+
+	if (cfg->median >= 3) {
+		v = hx711_filter_median(filter, v);
+	}
+	if (cfg->average >= 2) {
+		v = hx711_filter_average(filter, v);
+	}
+	if (cfg->iir_shift > 0) {
+		v = hx711_filter_iir(filter, v);
+	}
+	if (cfg->biquad) {
+		v = hx711_filter_biquad(filter, v);
+	}
+	filter->primed = true;
+	filter->value = v;
+
+	/* The low-pass stages above are the anti-aliasing for the decimator */
+	if (cfg->decimate >= 2) {
+		if (++filter->decimate_count < cfg->decimate) {
+			return false;
+		}
+		filter->decimate_count = 0;
+	}
+
+	*out = v;
+	return true;
+}
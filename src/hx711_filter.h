@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_FILTER_H_
+#define HX711_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-sensor integer filter chain, stages run in this order and each one
+ * is skipped when disabled:
+ *
+ *   median-of-N -> moving average -> first-order IIR -> biquad -> N:1 decimation
+ *
+ * All state is statically sized by Kconfig, nothing is allocated.
+ */
+
+#define HX711_FILTER_BIQUAD_Q 14
+
+struct hx711_filter_config {
+	uint8_t median;        /* Window, odd, below 3 disables */
+	uint8_t average;       /* Window, below 2 disables */
+	uint8_t iir_shift;     /* y += (x - y) / 2^shift, 0 disables */
+	uint8_t decimate;      /* Keep one output in N, below 2 disables */
+	bool biquad;
+	int32_t biquad_q14[5]; /* b0 b1 b2 a1 a2 in Q2.14, a0 = 1 */
+};
+
+struct hx711_filter {
+	const struct hx711_filter_config *cfg;
+	bool primed;
+
+	int32_t median_buf[CONFIG_HX711_FILTER_MEDIAN_MAX];
+	uint8_t median_pos;
+	uint8_t median_fill;
+
+	int32_t average_buf[CONFIG_HX711_FILTER_AVERAGE_MAX];
+	int32_t average_sum;   /* 24-bit samples, at most 128 of them */
+	uint8_t average_pos;
+	uint8_t average_fill;
+
+	int64_t iir_acc;       /* Output scaled by 2^iir_shift */
+
+	int32_t bq_x[2];
+	int32_t bq_y[2];
+
+	uint8_t decimate_count;
+	int32_t value;         /* Newest output of the low-pass stages */
+};
+
+void hx711_filter_init(struct hx711_filter *filter, const struct hx711_filter_config *cfg);
+
+/* Clears the history, e.g. after a gain change or a read error */
+void hx711_filter_reset(struct hx711_filter *filter);
+
+/* Feed one conversion, returns true when *out holds an output sample */
+bool hx711_filter_run(struct hx711_filter *filter, int32_t in, int32_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_FILTER_H_ */
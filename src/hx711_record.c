@@ -0,0 +1,606 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_record.h"
+#include "hx711_acq.h"
+#include "hx711_align.h"
+#include "hx711_block.h"
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/printk.h>
+#include <errno.h>
+#include <string.h>
+#ifdef CONFIG_HX711_SHELL
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#endif
+
+#define RECORD_BATCH_SIZE 16
+#define RECORD_AREA_ID    FIXED_PARTITION_ID(hx711_log_partition)
+#define RECORD_MAGIC      0x48583731 /* "HX71" */
+
+/* Entries are padded to the flash write block, which is at most this */
+#define RECORD_MAX_ALIGN 8
+
+BUILD_ASSERT(CONFIG_HX711_RECORD_BLOCK_SIZE >=
+	     HX711_BLOCK_HEADER_SIZE + HX711_BLOCK_MAX_FRAME(HX711_ALIGN_MAX_CHANNELS),
+	     "CONFIG_HX711_RECORD_BLOCK_SIZE cannot hold one frame");
+
+/* First block of every sector, keyed by boot << 48 | uptime in ms */
+struct record_index {
+	uint64_t key;
+	uint32_t erases;       /* Lets an export notice its sector was recycled */
+	bool valid;
+};
+
+HX711_RING_DEFINE(record_ring);
+
+static struct fcb record_fcb;
+static struct flash_sector record_sectors[CONFIG_HX711_RECORD_MAX_SECTORS];
+static struct record_index record_index[CONFIG_HX711_RECORD_MAX_SECTORS];
+
+/* Serialises the writer against flush, erase and the export cursor */
+static K_MUTEX_DEFINE(record_lock);
+/* One export at a time owns the read buffer */
+static K_MUTEX_DEFINE(record_export_lock);
+
+static uint8_t record_buf[CONFIG_HX711_RECORD_BLOCK_SIZE + RECORD_MAX_ALIGN];
+static uint8_t record_read_buf[CONFIG_HX711_RECORD_BLOCK_SIZE + RECORD_MAX_ALIGN];
+static struct hx711_block record_block;
+static struct hx711_align record_align;
+static uint8_t record_channels;
+static uint16_t record_boot;
+static uint32_t record_seq;
+static struct hx711_record_info record_info;
+
+static uint64_t record_key(const struct hx711_block_header *hdr)
+{
+	return ((uint64_t)hdr->boot << 48) | (hdr->time_ms & BIT64_MASK(48));
+}
+
+static size_t record_sector_idx(const struct flash_sector *sector)
+{
+	return sector - record_fcb.f_sectors;
+}
+
+static int record_read_header(const struct fcb_entry *loc, struct hx711_block_header *hdr)
+{
+	uint8_t buf[HX711_BLOCK_HEADER_SIZE];
+	int ret;
+
+	if (loc->fe_data_len < sizeof(buf)) {
+		return -EBADMSG;
+	}
+
+	ret = flash_area_read(record_fcb.fap, FCB_ENTRY_FA_DATA_OFF((*loc)), buf, sizeof(buf));
+	if (ret < 0) {
+		return ret;
+	}
+
+	return hx711_block_parse_header(buf, loc->fe_data_len, hdr);
+}
+
+static void record_index_add(const struct fcb_entry *loc, const struct hx711_block_header *hdr)
+{
+	struct record_index *index = &record_index[record_sector_idx(loc->fe_sector)];
+
+	if (!index->valid) {
+		index->key = record_key(hdr);
+		index->valid = true;
+	}
+}
+
+/* Rebuild the index and continue the sequence and boot numbers */
+static void record_scan(void)
+{
+	struct fcb_entry loc = { 0 };
+	struct hx711_block_header hdr;
+	bool found = false;
+
+	while (fcb_getnext(&record_fcb, &loc) == 0) {
+		if (record_read_header(&loc, &hdr) < 0) {
+			continue;
+		}
+
+		record_index_add(&loc, &hdr);
+		record_seq = hdr.seq + 1;
+		record_boot = hdr.boot;
+		found = true;
+	}
+
+	if (found) {
+		record_boot++;
+	}
+}
+
+/* Entry before the block holding key, the sector start for its first block */
+static void record_seek(uint64_t key, struct fcb_entry *from)
+{
+	size_t oldest = record_sector_idx(record_fcb.f_oldest);
+	struct flash_sector *sector = record_fcb.f_oldest;
+	struct fcb_entry loc, before;
+	struct hx711_block_header hdr;
+
+	for (size_t i = 0; i < record_fcb.f_sector_cnt; i++) {
+		size_t idx = (oldest + i) % record_fcb.f_sector_cnt;
+
+		if (record_index[idx].valid && record_index[idx].key <= key) {
+			sector = &record_fcb.f_sectors[idx];
+		}
+		if (&record_fcb.f_sectors[idx] == record_fcb.f_active.fe_sector) {
+			break;
+		}
+	}
+
+	from->fe_sector = sector;
+	from->fe_elem_off = 0;
+
+	loc = *from;
+	before = *from;
+	while (fcb_getnext(&record_fcb, &loc) == 0 && loc.fe_sector == sector) {
+		if (record_read_header(&loc, &hdr) < 0 || record_key(&hdr) > key) {
+			break;
+		}
+		*from = before;
+		before = loc;
+	}
+}
+
+static int record_write(void)
+{
+	struct fcb_entry loc;
+	size_t len;
+	int ret;
+
+	/* No block open, flushed or erased since the last frame */
+	if (record_block.buf == NULL || record_block.hdr.frames == 0) {
+		return 0;
+	}
+
+	len = hx711_block_finish(&record_block);
+	memset(&record_buf[len], 0, sizeof(record_buf) - len);
+	len = ROUND_UP(len, record_fcb.f_align);
+
+	ret = fcb_append(&record_fcb, len, &loc);
+	if (ret == -ENOSPC) {
+		/* Full, recycle the oldest sector */
+		struct record_index *index = &record_index[record_sector_idx(record_fcb.f_oldest)];
+
+		index->valid = false;
+		index->erases++;
+		ret = fcb_rotate(&record_fcb);
+		if (ret == 0) {
+			record_info.recycled++;
+			ret = fcb_append(&record_fcb, len, &loc);
+		}
+	}
+	if (ret == 0) {
+		ret = flash_area_write(record_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), record_buf, len);
+	}
+	if (ret == 0) {
+		ret = fcb_append_finish(&record_fcb, &loc);
+	}
+
+	if (ret < 0) {
+		record_info.errors++;
+		return ret;
+	}
+
+	record_index_add(&loc, &record_block.hdr);
+	record_info.blocks++;
+	record_info.bytes += len;
+
+	return 0;
+}
+
+static void record_open(const struct hx711_align_frame *frame)
+{
+	struct hx711_block_header hdr = {
+		.channels = record_channels,
+		.boot = record_boot,
+		.seq = record_seq++,
+		.period_us = k_cyc_to_us_near32(record_align.period),
+	};
+
+	/* Uptime of the grid point, it lies at most the align timeout back */
+	hdr.time_ms = k_uptime_get() - k_cyc_to_ms_near32(k_cycle_get_32() - frame->timestamp);
+
+	hx711_block_start(&record_block, record_buf, CONFIG_HX711_RECORD_BLOCK_SIZE, &hdr,
+			  record_align.period);
+}
+
+static void record_aligned(const struct hx711_align_frame *frame, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (record_block.buf == NULL) {
+		record_open(frame);
+	}
+
+	/* A full block goes to flash, the frame starts the next one */
+	if (!hx711_block_add(&record_block, frame)) {
+		(void)record_write();
+		record_open(frame);
+		(void)hx711_block_add(&record_block, frame);
+	}
+
+	record_info.frames++;
+	record_info.raw_bytes += 10 + DIV_ROUND_UP(record_channels, 8) + 3 * record_channels;
+}
+
+static void record_thread(void *p1, void *p2, void *p3)
+{
+	struct hx711_sample batch[RECORD_BATCH_SIZE];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		size_t count = hx711_ring_get(&record_ring, batch, ARRAY_SIZE(batch), K_FOREVER);
+
+		k_mutex_lock(&record_lock, K_FOREVER);
+		for (size_t i = 0; i < count; i++) {
+			hx711_align_put(&record_align, &batch[i]);
+		}
+		k_mutex_unlock(&record_lock);
+	}
+}
+
+K_THREAD_DEFINE(hx711_record_tid, CONFIG_HX711_RECORD_STACK_SIZE, record_thread,
+		NULL, NULL, NULL, CONFIG_HX711_RECORD_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+/* FCB sectors of whole flash pages, few enough for the index */
+static int record_layout(void)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info page;
+	size_t pages, sector_size;
+	int ret;
+
+	ret = flash_area_open(RECORD_AREA_ID, &fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off, &page);
+	if (ret == 0) {
+		pages = fa->fa_size / page.size;
+		sector_size = page.size * DIV_ROUND_UP(pages, CONFIG_HX711_RECORD_MAX_SECTORS);
+		record_fcb.f_sector_cnt = fa->fa_size / sector_size;
+		record_info.sector_size = sector_size;
+
+		for (uint8_t i = 0; i < record_fcb.f_sector_cnt; i++) {
+			record_sectors[i].fs_off = i * sector_size;
+			record_sectors[i].fs_size = sector_size;
+		}
+
+		/* Rotation needs a sector to move on to */
+		if (record_fcb.f_sector_cnt < 2) {
+			ret = -ENOSPC;
+		}
+	}
+
+	flash_area_close(fa);
+
+	return ret;
+}
+
+int hx711_record_init(uint8_t num_channels)
+{
+	const struct flash_area *fa;
+	int ret;
+
+	ret = hx711_align_init(&record_align, num_channels, record_aligned, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = record_layout();
+	if (ret < 0) {
+		printk("Log partition unusable: %d\n", ret);
+		return ret;
+	}
+
+	record_fcb.f_magic = RECORD_MAGIC;
+	record_fcb.f_version = HX711_BLOCK_VERSION;
+	record_fcb.f_scratch_cnt = 0;
+	record_fcb.f_sectors = record_sectors;
+
+	ret = fcb_init(RECORD_AREA_ID, &record_fcb);
+	if (ret == -ENOMSG && flash_area_open(RECORD_AREA_ID, &fa) == 0) {
+		/* Another layout or format, start over */
+		printk("Log partition holds foreign data, erasing\n");
+		ret = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+		if (ret == 0) {
+			ret = fcb_init(RECORD_AREA_ID, &record_fcb);
+		}
+	}
+	if (ret < 0) {
+		printk("Failed to open the log: %d\n", ret);
+		return ret;
+	}
+
+	if (record_fcb.f_align > RECORD_MAX_ALIGN) {
+		return -ENOTSUP;
+	}
+
+	record_scan();
+
+	ret = hx711_acq_add_consumer(&record_ring);
+	if (ret < 0) {
+		return ret;
+	}
+
+	record_channels = num_channels;
+	record_info.boot = record_boot;
+	record_info.sectors = record_fcb.f_sector_cnt;
+	printk("Recording boot %u, %u sectors of %u bytes\n", record_boot,
+	       record_fcb.f_sector_cnt, record_info.sector_size);
+	k_thread_start(hx711_record_tid);
+
+	return 0;
+}
+
+int hx711_record_export(uint16_t boot, uint64_t from_ms, hx711_record_cb_t cb, void *user_data)
+{
+	uint64_t key = ((uint64_t)boot << 48) | (from_ms & BIT64_MASK(48));
+	struct hx711_block_header hdr;
+	struct fcb_entry loc;
+	uint32_t next_seq = 0;
+	uint32_t erases = 0;
+	size_t idx = SIZE_MAX;
+	bool first = true;
+	int ret = 0;
+
+	k_mutex_lock(&record_export_lock, K_FOREVER);
+	k_mutex_lock(&record_lock, K_FOREVER);
+	record_seek(key, &loc);
+
+	while (1) {
+		/* The writer recycled the sector under the cursor, resume at the oldest */
+		if (idx != SIZE_MAX && record_index[idx].erases != erases) {
+			loc.fe_sector = NULL;
+		}
+
+		if (fcb_getnext(&record_fcb, &loc) != 0) {
+			break;
+		}
+
+		if (record_sector_idx(loc.fe_sector) != idx) {
+			idx = record_sector_idx(loc.fe_sector);
+			erases = record_index[idx].erases;
+		}
+
+		if (loc.fe_data_len > sizeof(record_read_buf) ||
+		    flash_area_read(record_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), record_read_buf,
+				    loc.fe_data_len) < 0 ||
+		    hx711_block_parse_header(record_read_buf, loc.fe_data_len, &hdr) < 0) {
+			continue;
+		}
+
+		/* Sequence numbers skip what a resume would hand out twice */
+		if (!first && (int32_t)(hdr.seq - next_seq) < 0) {
+			continue;
+		}
+		first = false;
+		next_seq = hdr.seq + 1;
+
+		/* Printing is slow, let the writer run meanwhile */
+		k_mutex_unlock(&record_lock);
+		ret = cb(record_read_buf, hdr.length, user_data);
+		k_mutex_lock(&record_lock, K_FOREVER);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(&record_lock);
+	k_mutex_unlock(&record_export_lock);
+
+	return ret;
+}
+
+int hx711_record_flush(void)
+{
+	int ret;
+
+	k_mutex_lock(&record_lock, K_FOREVER);
+	ret = record_write();
+	/* The next frame opens a new block */
+	record_block.buf = NULL;
+	k_mutex_unlock(&record_lock);
+
+	return ret;
+}
+
+int hx711_record_erase(void)
+{
+	int ret;
+
+	k_mutex_lock(&record_lock, K_FOREVER);
+	ret = fcb_clear(&record_fcb);
+	for (size_t i = 0; i < ARRAY_SIZE(record_index); i++) {
+		record_index[i].valid = false;
+		record_index[i].erases++;
+	}
+	record_block.buf = NULL;
+	k_mutex_unlock(&record_lock);
+
+	return ret;
+}
+
+void hx711_record_get_info(struct hx711_record_info *info)
+{
+	k_mutex_lock(&record_lock, K_FOREVER);
+	*info = record_info;
+	k_mutex_unlock(&record_lock);
+
+	info->dropped = hx711_ring_overruns(&record_ring);
+}
+
+#ifdef CONFIG_HX711_SHELL
+static int record_shell_args(const struct shell *sh, size_t argc, char **argv, uint16_t *boot,
+			     uint64_t *from_ms)
+{
+	char *end;
+
+	*boot = argc > 1 ? strtoul(argv[1], &end, 0) : 0;
+	if (argc > 1 && *end != '\0') {
+		shell_error(sh, "Bad boot number %s", argv[1]);
+		return -EINVAL;
+	}
+
+	*from_ms = argc > 2 ? strtoull(argv[2], &end, 0) : 0;
+	if (argc > 2 && *end != '\0') {
+		shell_error(sh, "Bad uptime %s", argv[2]);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* One line of hex per block, tools/hx711_log_decode.py turns it into CSV */
+static int record_shell_hex(const uint8_t *block, size_t len, void *user_data)
+{
+	const struct shell *sh = user_data;
+	char hex[2 * 32 + 1];
+
+	for (size_t off = 0; off < len; off += 32) {
+		bin2hex(&block[off], MIN(len - off, 32), hex, sizeof(hex));
+		shell_fprintf(sh, SHELL_NORMAL, "%s", hex);
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+	return 0;
+}
+
+static int record_shell_csv(const uint8_t *block, size_t len, void *user_data)
+{
+	const struct shell *sh = user_data;
+	struct hx711_block_reader reader;
+	int32_t values[HX711_ALIGN_MAX_CHANNELS];
+	uint64_t time_us;
+	uint32_t stale;
+
+	if (hx711_block_reader_init(&reader, block, len) < 0) {
+		return 0;
+	}
+
+	while (hx711_block_next(&reader, &time_us, &stale, values) == 0) {
+		shell_fprintf(sh, SHELL_NORMAL, "%u,%llu.%03u,%x", reader.hdr.boot,
+			      (unsigned long long)(time_us / USEC_PER_MSEC),
+			      (uint32_t)(time_us % USEC_PER_MSEC), stale);
+		for (uint8_t i = 0; i < reader.hdr.channels; i++) {
+			shell_fprintf(sh, SHELL_NORMAL, ",%d", values[i]);
+		}
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
+	}
+
+	return 0;
+}
+
+static int cmd_hx711_log_info(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hx711_record_info info;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	hx711_record_get_info(&info);
+	shell_print(sh, "boot %u, %u sectors of %u bytes", info.boot, info.sectors,
+		    info.sector_size);
+	shell_print(sh, "frames %u blocks %u recycled %u errors %u dropped %u", info.frames,
+		    info.blocks, info.recycled, info.errors, info.dropped);
+	if (info.bytes > 0) {
+		shell_print(sh, "%u bytes for %u as stream records, %u.%02ux", info.bytes,
+			    info.raw_bytes, info.raw_bytes / info.bytes,
+			    (uint32_t)((uint64_t)(info.raw_bytes % info.bytes) * 100 / info.bytes));
+	}
+
+	return 0;
+}
+
+static int cmd_hx711_log_export(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t boot;
+	uint64_t from_ms;
+	int ret;
+
+	ret = record_shell_args(sh, argc, argv, &boot, &from_ms);
+	if (ret == 0) {
+		ret = hx711_record_export(boot, from_ms, record_shell_hex, (void *)sh);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_log_print(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t boot;
+	uint64_t from_ms;
+	int ret;
+
+	ret = record_shell_args(sh, argc, argv, &boot, &from_ms);
+	if (ret == 0) {
+		shell_print(sh, "boot,time_ms,stale_mask,ch0,...");
+		ret = hx711_record_export(boot, from_ms, record_shell_csv, (void *)sh);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_log_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = hx711_record_flush();
+	if (ret < 0) {
+		shell_error(sh, "Flush failed: %d", ret);
+	}
+
+	return ret;
+}
+
+static int cmd_hx711_log_erase(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = hx711_record_erase();
+	if (ret < 0) {
+		shell_error(sh, "Erase failed: %d", ret);
+	} else {
+		shell_print(sh, "Log erased");
+	}
+
+	return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_hx711_log,
+	SHELL_CMD(info, NULL, "Recording counters and compression ratio", cmd_hx711_log_info),
+	SHELL_CMD_ARG(export, NULL,
+		      "Dump blocks as hex lines from [boot [uptime ms]] on",
+		      cmd_hx711_log_export, 1, 2),
+	SHELL_CMD_ARG(print, NULL,
+		      "Decode frames as CSV from [boot [uptime ms]] on",
+		      cmd_hx711_log_print, 1, 2),
+	SHELL_CMD(flush, NULL, "Write the block being filled", cmd_hx711_log_flush),
+	SHELL_CMD(erase, NULL, "Erase the whole log", cmd_hx711_log_erase),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((hx711), log, &sub_hx711_log, "Recorded history in flash", NULL, 1, 0);
+#endif /* CONFIG_HX711_SHELL */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_RECORD_H_
+#define HX711_RECORD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * On-device recording. Aligned frames are delta coded into blocks of at
+ * most CONFIG_HX711_RECORD_BLOCK_SIZE bytes (see hx711_block.h) and every
+ * full block is appended as one entry to a flash circular buffer (FCB) on
+ * the hx711_log_partition. When the partition is full the oldest sector
+ * is erased, so the log always holds the most recent history.
+ *
+ * Blocks are stamped with a boot number, one more than the newest block
+ * found at init, and the uptime of their first frame. A per-sector index
+ * of the first block lets an export seek to a (boot, uptime) position
+ * without reading the sectors before it.
+ */
+
+struct hx711_record_info {
+	uint32_t frames;       /* Recorded since boot */
+	uint32_t blocks;       /* Written since boot */
+	uint32_t bytes;        /* Flash used by those blocks */
+	uint32_t raw_bytes;    /* The same frames as binary stream records */
+	uint32_t recycled;     /* Sectors erased to make room */
+	uint32_t errors;       /* Blocks that failed to write */
+	uint32_t dropped;      /* Samples lost to a full ring */
+	uint16_t boot;
+	uint8_t sectors;
+	uint32_t sector_size;
+};
+
+/* Returns 0 to go on, anything else stops the export and is returned */
+typedef int (*hx711_record_cb_t)(const uint8_t *block, size_t len, void *user_data);
+
+/* Register the recording consumer, call before hx711_acq_start() */
+int hx711_record_init(uint8_t num_channels);
+
+/* Hand every stored block from the one holding uptime from_ms of boot on,
+ * oldest first, to cb. Blocks written meanwhile are included.
+ */
+int hx711_record_export(uint16_t boot, uint64_t from_ms, hx711_record_cb_t cb, void *user_data);
+
+/* Write the block being filled, even if it is not full */
+int hx711_record_flush(void);
+
+/* Erase every stored block, the boot number is kept */
+int hx711_record_erase(void);
+
+void hx711_record_get_info(struct hx711_record_info *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_RECORD_H_ */
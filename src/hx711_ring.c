@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_ring.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HX711_RING_SIZE),
+	     "CONFIG_HX711_RING_SIZE must be a power of two");
+
+void hx711_ring_init(struct hx711_ring *ring)
+{
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	atomic_set(&ring->overruns, 0);
+	k_sem_init(&ring->data, 0, 1);
+}
+
+bool hx711_ring_put(struct hx711_ring *ring, const struct hx711_sample *sample)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+	if (head - tail > ring->mask) {
+		atomic_inc(&ring->overruns);
+		return false;
+	}
+
+	ring->buf[head & ring->mask] = *sample;
+
+	/* Publish the slot only after it has been written */
+	atomic_set(&ring->head, (atomic_val_t)(head + 1));
+
+	return true;
+}
+
+void hx711_ring_notify(struct hx711_ring *ring)
+{
+	k_sem_give(&ring->data);
+}
+
+size_t hx711_ring_get(struct hx711_ring *ring, struct hx711_sample *samples, size_t max,
+		      k_timeout_t timeout)
+{
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+	size_t count;
+
+	if (head == tail) {
+		if (k_sem_take(&ring->data, timeout) < 0) {
+			return 0;
+		}
+		head = (uint32_t)atomic_get(&ring->head);
+	}
+
+	count = MIN((size_t)(head - tail), max);
+	for (size_t i = 0; i < count; i++) {
+		samples[i] = ring->buf[(tail + i) & ring->mask];
+	}
+
+	/* Hand the slots back to the producer only after they are copied */
+	atomic_set(&ring->tail, (atomic_val_t)(tail + count));
+
+	return count;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_RING_H_
+#define HX711_RING_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Sample status flags */
+#define HX711_SAMPLE_ERROR BIT(0) /* Read failed, raw holds the negative errno */
+#define HX711_SAMPLE_IDLE  BIT(1) /* Converted at the idle rate, see hx711_adapt.h */
+
+/* One conversion as produced by the acquisition thread */
+struct hx711_sample {
+	uint32_t timestamp; /* Cycle count at data ready */
+	int32_t raw;        /* Signed 24-bit conversion */
+	uint8_t sensor_id;
+	uint8_t status;
+};
+
+/*
+ * Lock-free single-producer/single-consumer sample ring. Only the producer
+ * writes head and only the consumer writes tail, so neither side takes a
+ * lock. A full ring drops the new sample and counts an overrun, the
+ * producer never blocks on a slow consumer.
+ */
+struct hx711_ring {
+	struct hx711_sample *buf;
+	uint32_t mask;       /* Size - 1, size is a power of two */
+	atomic_t head;       /* Next slot to write, producer owned */
+	atomic_t tail;       /* Next slot to read, consumer owned */
+	atomic_t overruns;   /* Samples dropped because the ring was full */
+	struct k_sem data;   /* Wakes the consumer */
+};
+
+/* Define a ring of CONFIG_HX711_RING_SIZE samples, call hx711_ring_init() */
+#define HX711_RING_DEFINE(name)                                                     \
+	static struct hx711_sample name##_buf[CONFIG_HX711_RING_SIZE];             \
+	static struct hx711_ring name = {                                          \
+		.buf = name##_buf,                                                 \
+		.mask = CONFIG_HX711_RING_SIZE - 1,                                \
+	}
+
+void hx711_ring_init(struct hx711_ring *ring);
+
+/* Producer side */
+bool hx711_ring_put(struct hx711_ring *ring, const struct hx711_sample *sample);
+void hx711_ring_notify(struct hx711_ring *ring);
+
+/* Consumer side, waits up to timeout for the first sample */
+size_t hx711_ring_get(struct hx711_ring *ring, struct hx711_sample *samples, size_t max,
+		      k_timeout_t timeout);
+
+static inline uint32_t hx711_ring_overruns(struct hx711_ring *ring)
+{
+	return (uint32_t)atomic_get(&ring->overruns);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_RING_H_ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_driver.h"
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Each PD_SCK pulse is two MOSI bits, '1' for the high phase and '0' for
+ * the low phase, so one byte carries four pulses. 24 data pulses plus
+ * 1 to 3 gain pulses fit in 7 bytes, the tail of the last byte keeps
+ * PD_SCK low. Indexed by the number of gain pulses minus one.
+ */
+static uint8_t hx711_spi_tx[3][HX711_SPI_FRAME_LEN] = {
+	{ 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x80 }, /* A/128 */
+	{ 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA0 }, /* B/32 */
+	{ 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA8 }, /* A/64 */
+};
+
+static uint8_t *hx711_spi_frame(const struct hx711_data *data)
+{
+	return hx711_spi_tx[hx711_gain_pulses(data->next_gain) - 1];
+}
+
+static int32_t hx711_spi_decode(const uint8_t *rx)
+{
+	int32_t raw_value = 0;
+
+	/* DOUT is valid after the rising edge, sample it in the low phase */
+	for (uint8_t i = 0; i < 24; i++) {
+		uint8_t bit = (rx[i / 4] >> (6 - 2 * (i % 4))) & 1;
+
+		raw_value = (raw_value << 1) | bit;
+	}
+
+	return raw_value;
+}
+
+int hx711_spi_clock_out(const struct device *dev, int32_t *value)
+{
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
+	const struct spi_buf tx_buf = {
+		.buf = hx711_spi_frame(data),
+		.len = HX711_SPI_FRAME_LEN,
+	};
+	const struct spi_buf rx_buf = {
+		.buf = data->spi_rx,
+		.len = sizeof(data->spi_rx),
+	};
+	const struct spi_buf_set tx = { .buffers = &tx_buf, .count = 1 };
+	const struct spi_buf_set rx = { .buffers = &rx_buf, .count = 1 };
+	int ret;
+
+	/* The controller's DMA runs the frame, this thread sleeps meanwhile */
+	ret = spi_transceive_dt(&cfg->spi, &tx, &rx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*value = hx711_spi_decode(data->spi_rx);
+	return 0;
+}
+
+#ifdef CONFIG_SPI_ASYNC
+static void hx711_spi_done(const struct device *spi, int result, void *user_data)
+{
+	struct hx711_data *data = user_data;
+	int32_t value = 0;
+
+	ARG_UNUSED(spi);
+
+	hx711_transfer_end(data->dev);
+	if (result == 0) {
+		if (hx711_conversion_done(data->dev)) {
+			value = hx711_sign_extend(hx711_spi_decode(data->spi_rx));
+			HX711_STATS_VALUE(&data->stats, value);
+		} else {
+			result = -EAGAIN;
+		}
+	}
+
+	data->spi_cb(data->dev, result, value, data->spi_cb_data);
+}
+
+int hx711_spi_read_async(const struct device *dev, hx711_spi_callback_t cb, void *user_data)
+{
+	const struct hx711_config *cfg = dev->config;
+	struct hx711_data *data = dev->data;
+	int ret;
+
+	if (!cfg->use_spi || !cb) {
+		return -EINVAL;
+	}
+
+	if (!hx711_is_data_ready(dev)) {
+		return -EAGAIN;
+	}
+
+	data->spi_cb = cb;
+	data->spi_cb_data = user_data;
+	data->spi_rx_buf.buf = data->spi_rx;
+	data->spi_rx_buf.len = sizeof(data->spi_rx);
+	data->spi_rx_set.buffers = &data->spi_rx_buf;
+	data->spi_rx_set.count = 1;
+	data->spi_tx_buf.buf = hx711_spi_frame(data);
+	data->spi_tx_buf.len = HX711_SPI_FRAME_LEN;
+	data->spi_tx_set.buffers = &data->spi_tx_buf;
+	data->spi_tx_set.count = 1;
+
+	hx711_transfer_begin(dev);
+
+	ret = spi_transceive_cb(cfg->spi.bus, &cfg->spi.config, &data->spi_tx_set,
+				&data->spi_rx_set, hx711_spi_done, data);
+	if (ret < 0) {
+		hx711_transfer_end(dev);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SPI_ASYNC */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_driver.h"
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/printk.h>
+#include <stddef.h>
+#include <string.h>
+#ifdef CONFIG_HX711_SHELL
+#include <zephyr/shell/shell.h>
+#endif
+
+/* Counters of the stats section, everything after the header */
+#define HX711_STATS_FIRST offsetof(struct hx711_stats, conversions)
+#define HX711_STATS_COUNT ((sizeof(struct hx711_stats) - HX711_STATS_FIRST) / sizeof(uint32_t))
+
+BUILD_ASSERT(sizeof(struct hx711_stats) - HX711_STATS_FIRST ==
+	     HX711_STATS_COUNT * sizeof(uint32_t), "stats section must be uint32_t only");
+
+#if defined(CONFIG_STATS) && defined(CONFIG_STATS_NAMES)
+#define HX711_STATS_NAME(field, name) { offsetof(struct hx711_stats, field), name }
+
+static const struct stats_name_map hx711_stats_names[] = {
+	HX711_STATS_NAME(conversions, "conversions"),
+	HX711_STATS_NAME(timeouts, "timeouts"),
+	HX711_STATS_NAME(missed, "missed"),
+	HX711_STATS_NAME(saturated, "saturated"),
+	HX711_STATS_NAME(stretched, "stretched"),
+	HX711_STATS_NAME(quarantines, "quarantines"),
+	HX711_STATS_NAME(latency_max_cycles, "latency_max_cycles"),
+	HX711_STATS_NAME(latency_hist[0], "latency_hist0"),
+	HX711_STATS_NAME(latency_hist[1], "latency_hist1"),
+	HX711_STATS_NAME(latency_hist[2], "latency_hist2"),
+	HX711_STATS_NAME(latency_hist[3], "latency_hist3"),
+	HX711_STATS_NAME(latency_hist[4], "latency_hist4"),
+	HX711_STATS_NAME(latency_hist[5], "latency_hist5"),
+	HX711_STATS_NAME(latency_hist[6], "latency_hist6"),
+	HX711_STATS_NAME(latency_hist[7], "latency_hist7"),
+	HX711_STATS_NAME(latency_hist[8], "latency_hist8"),
+	HX711_STATS_NAME(latency_hist[9], "latency_hist9"),
+	HX711_STATS_NAME(bus_cycles, "bus_cycles"),
+	HX711_STATS_NAME(bus_max_cycles, "bus_max_cycles"),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(hx711_stats_names) == HX711_STATS_COUNT, "unnamed hx711 counter");
+#endif
+
+static const uint32_t *hx711_stats_counters(const struct hx711_stats *stats)
+{
+	return (const uint32_t *)((const uint8_t *)stats + HX711_STATS_FIRST);
+}
+
+int hx711_get_stats(const struct device *dev, struct hx711_stats *stats)
+{
+	const struct hx711_data *data = dev->data;
+	const uint32_t *src = hx711_stats_counters(&data->stats);
+	uint32_t *dst;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	dst = (uint32_t *)hx711_stats_counters(stats);
+	memset(stats, 0, sizeof(*stats));
+	for (size_t i = 0; i < HX711_STATS_COUNT; i++) {
+		dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+	}
+
+	return 0;
+}
+
+/* An increment racing with the reset may survive it, nothing is lost otherwise */
+int hx711_reset_stats(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+	uint32_t *counters = (uint32_t *)hx711_stats_counters(&data->stats);
+
+	for (size_t i = 0; i < HX711_STATS_COUNT; i++) {
+		__atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+	}
+
+	return 0;
+}
+
+void hx711_stats_init(const struct device *dev)
+{
+	struct hx711_data *data = dev->data;
+
+#ifdef CONFIG_STATS
+	int ret;
+
+	stats_init(&data->stats.s_hdr, STATS_SIZE_32, HX711_STATS_COUNT,
+#ifdef CONFIG_STATS_NAMES
+		   hx711_stats_names, ARRAY_SIZE(hx711_stats_names));
+#else
+		   NULL, 0);
+#endif
+	ret = stats_register(dev->name, &data->stats.s_hdr);
+	if (ret < 0) {
+		printk("%s: failed to register stats: %d\n", dev->name, ret);
+	}
+#endif
+
+	(void)hx711_reset_stats(dev);
+}
+
+#ifdef CONFIG_HX711_SHELL
+static const struct device *const hx711_shell_devs[] = { HX711_DT_DEVICES };
+
+static void hx711_shell_print(const struct shell *sh, const struct device *dev)
+{
+	struct hx711_stats stats;
+	uint32_t mean_bus_us = 0;
+
+	(void)hx711_get_stats(dev, &stats);
+	if (stats.conversions > 0) {
+		mean_bus_us = k_cyc_to_us_floor64(stats.bus_cycles) / stats.conversions;
+	}
+
+	shell_print(sh, "%s: conversions %u timeouts %u missed %u saturated %u stretched %u",
+		    dev->name, stats.conversions, stats.timeouts, stats.missed, stats.saturated,
+		    stats.stretched);
+	shell_print(sh, "  quarantined %u times", stats.quarantines);
+	shell_print(sh, "  bus per frame %u us (max %u us)", mean_bus_us,
+		    k_cyc_to_us_floor32(stats.bus_max_cycles));
+
+	if (!IS_ENABLED(CONFIG_HX711_TRIGGER)) {
+		return;
+	}
+
+	shell_print(sh, "  data-ready to read latency, max %u us",
+		    k_cyc_to_us_floor32(stats.latency_max_cycles));
+	for (uint8_t i = 0; i < HX711_STATS_LATENCY_BINS; i++) {
+		if (i < HX711_STATS_LATENCY_BINS - 1) {
+			shell_print(sh, "    < %6u us: %u", k_cyc_to_us_ceil32(BIT(i + 1)),
+				    stats.latency_hist[i]);
+		} else {
+			shell_print(sh, "   >= %6u us: %u", k_cyc_to_us_ceil32(BIT(i)),
+				    stats.latency_hist[i]);
+		}
+	}
+}
+
+/* Every sensor without an argument, else the named one */
+static int hx711_shell_for_each(const struct shell *sh, size_t argc, char **argv,
+				void (*fn)(const struct shell *sh, const struct device *dev))
+{
+	bool found = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_shell_devs); i++) {
+		if (argc > 1 && strcmp(argv[1], hx711_shell_devs[i]->name) != 0) {
+			continue;
+		}
+		fn(sh, hx711_shell_devs[i]);
+		found = true;
+	}
+
+	if (!found) {
+		shell_error(sh, "No HX711 named %s", argv[1]);
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+static void hx711_shell_reset(const struct shell *sh, const struct device *dev)
+{
+	(void)hx711_reset_stats(dev);
+	shell_print(sh, "%s: counters cleared", dev->name);
+}
+
+static int cmd_hx711_snapshot(const struct shell *sh, size_t argc, char **argv)
+{
+	return hx711_shell_for_each(sh, argc, argv, hx711_shell_print);
+}
+
+static int cmd_hx711_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	return hx711_shell_for_each(sh, argc, argv, hx711_shell_reset);
+}
+
+static void hx711_shell_device_get(size_t idx, struct shell_static_entry *entry)
+{
+	entry->syntax = idx < ARRAY_SIZE(hx711_shell_devs) ? hx711_shell_devs[idx]->name : NULL;
+	entry->handler = NULL;
+	entry->help = NULL;
+	entry->subcmd = NULL;
+}
+
+SHELL_DYNAMIC_CMD_CREATE(dsub_hx711_device, hx711_shell_device_get);
+
+/* Other modules add their own subcommands to the set */
+SHELL_SUBCMD_SET_CREATE(sub_hx711, (hx711));
+
+SHELL_SUBCMD_ADD((hx711), snapshot, &dsub_hx711_device,
+		 "Print the counters of every sensor or of one [device]",
+		 cmd_hx711_snapshot, 1, 1);
+SHELL_SUBCMD_ADD((hx711), reset, &dsub_hx711_device,
+		 "Clear the counters of every sensor or of one [device]",
+		 cmd_hx711_reset, 1, 1);
+
+SHELL_CMD_REGISTER(hx711, &sub_hx711, "HX711 diagnostics", NULL);
+#endif /* CONFIG_HX711_SHELL */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_STATS_H_
+#define HX711_STATS_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+#include <stdint.h>
+#ifdef CONFIG_STATS
+#include <zephyr/stats/stats.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-sensor health and performance counters. Every counter has one
+ * writer, the context that reads the sensor, so the hot path is a relaxed
+ * load and store with no locking and no formatting. Readers take a copy
+ * with hx711_get_stats() and format it themselves.
+ */
+
+/* Bin n counts latencies below 2^(n + 1) cycles, the last bin the rest */
+#define HX711_STATS_LATENCY_BINS 10
+
+#ifdef CONFIG_HX711_STATS
+
+/* Laid out as a stats section, so CONFIG_STATS registers it as is */
+struct hx711_stats {
+#ifdef CONFIG_STATS
+	struct stats_hdr s_hdr;
+#endif
+	uint32_t conversions;        /* Frames clocked out, settling ones included */
+	uint32_t timeouts;           /* Waits for data-ready that ran out */
+	uint32_t missed;             /* Conversions lost before being read */
+	uint32_t saturated;          /* Conversions at 0x7FFFFF or 0x800000 */
+	uint32_t stretched;          /* Frames dropped for an overlong SCK high phase */
+	uint32_t quarantines;        /* Times the acquisition loop took the sensor out */
+	uint32_t latency_max_cycles; /* Worst data-ready to read latency */
+	uint32_t latency_hist[HX711_STATS_LATENCY_BINS];
+	uint32_t bus_cycles;         /* Time spent clocking frames out */
+	uint32_t bus_max_cycles;     /* Longest frame */
+};
+
+static inline void hx711_stats_add(uint32_t *counter, uint32_t n)
+{
+	__atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + n,
+			 __ATOMIC_RELAXED);
+}
+
+static inline void hx711_stats_max(uint32_t *counter, uint32_t value)
+{
+	if (value > __atomic_load_n(counter, __ATOMIC_RELAXED)) {
+		__atomic_store_n(counter, value, __ATOMIC_RELAXED);
+	}
+}
+
+static inline void hx711_stats_latency(struct hx711_stats *stats, uint32_t cycles)
+{
+	uint8_t bin = cycles < 2 ? 0 : MIN(31 - __builtin_clz(cycles),
+					   HX711_STATS_LATENCY_BINS - 1);
+
+	hx711_stats_add(&stats->latency_hist[bin], 1);
+	hx711_stats_max(&stats->latency_max_cycles, cycles);
+}
+
+static inline void hx711_stats_value(struct hx711_stats *stats, int32_t value)
+{
+	/* The output clips at full scale, a stuck bridge also lands here */
+	if (value == 0x7FFFFF || value == -0x800000) {
+		hx711_stats_add(&stats->saturated, 1);
+	}
+}
+
+static inline void hx711_stats_bus(struct hx711_stats *stats, uint32_t cycles)
+{
+	hx711_stats_add(&stats->bus_cycles, cycles);
+	hx711_stats_max(&stats->bus_max_cycles, cycles);
+}
+
+/* Take the sensor's struct hx711_stats, compile to nothing without HX711_STATS */
+#define HX711_STATS_INC(stats, field)      hx711_stats_add(&(stats)->field, 1)
+#define HX711_STATS_ADD(stats, field, n)   hx711_stats_add(&(stats)->field, (n))
+#define HX711_STATS_LATENCY(stats, cycles) hx711_stats_latency((stats), (cycles))
+#define HX711_STATS_VALUE(stats, value)    hx711_stats_value((stats), (value))
+#define HX711_STATS_BUS(stats, cycles)     hx711_stats_bus((stats), (cycles))
+
+/* Copy of the counters, each one read atomically */
+int hx711_get_stats(const struct device *dev, struct hx711_stats *stats);
+int hx711_reset_stats(const struct device *dev);
+
+/* Registers the counters with CONFIG_STATS under the device name */
+void hx711_stats_init(const struct device *dev);
+
+#else
+
+/* Empty, like a stats section without CONFIG_STATS */
+struct hx711_stats {
+};
+
+#define HX711_STATS_INC(stats, field)      ARG_UNUSED(stats)
+#define HX711_STATS_ADD(stats, field, n)   ARG_UNUSED(stats)
+#define HX711_STATS_LATENCY(stats, cycles) ARG_UNUSED(stats)
+#define HX711_STATS_VALUE(stats, value)    ARG_UNUSED(stats)
+#define HX711_STATS_BUS(stats, cycles)     ARG_UNUSED(stats)
+
+#endif /* CONFIG_HX711_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_STATS_H_ */
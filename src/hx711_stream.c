@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hx711_stream.h"
+#include "hx711_acq.h"
+#include "hx711_align.h"
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/printk.h>
+
+#define STREAM_BATCH_SIZE 16
+/* Frames are the aligned grid frames, the fresh mask is their stale mask inverted */
+#define STREAM_MAX_CHANNELS HX711_ALIGN_MAX_CHANNELS
+#define STREAM_MAX_FRAME (8 + DIV_ROUND_UP(STREAM_MAX_CHANNELS, 8) + \
+			  3 * STREAM_MAX_CHANNELS + 2)
+/* COBS adds one byte per 254 plus the code byte, then the delimiter */
+#define STREAM_MAX_ENCODED (STREAM_MAX_FRAME + STREAM_MAX_FRAME / 254 + 2)
+
+BUILD_ASSERT(CONFIG_HX711_STREAM_BUF_SIZE >= STREAM_MAX_ENCODED,
+	     "CONFIG_HX711_STREAM_BUF_SIZE cannot hold one frame");
+
+static const struct device *const stream_uart = DEVICE_DT_GET(DT_CHOSEN(hx711_stream_uart));
+
+HX711_RING_DEFINE(stream_ring);
+
+/* Double buffer: frames are packed into one while DMA sends the other */
+static uint8_t stream_buf[2][CONFIG_HX711_STREAM_BUF_SIZE];
+static size_t stream_len;
+static uint8_t stream_fill;
+static atomic_t stream_busy;
+static uint32_t stream_dropped;
+
+static uint8_t stream_channels;
+static uint16_t stream_seq;
+static struct hx711_align stream_align;
+
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out)
+{
+	size_t code_idx = 0;
+	size_t out_len = 1;
+	uint8_t code = 1;
+
+	for (size_t i = 0; i < len; i++) {
+		if (in[i] == 0) {
+			out[code_idx] = code;
+			code_idx = out_len++;
+			code = 1;
+			continue;
+		}
+
+		out[out_len++] = in[i];
+		if (++code == 0xFF) {
+			out[code_idx] = code;
+			code_idx = out_len++;
+			code = 1;
+		}
+	}
+
+	out[code_idx] = code;
+
+	return out_len;
+}
+
+static void stream_uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	if (evt->type == UART_TX_DONE || evt->type == UART_TX_ABORTED) {
+		atomic_clear(&stream_busy);
+	}
+}
+
+static void stream_kick(void)
+{
+	if (stream_len == 0 || !atomic_cas(&stream_busy, 0, 1)) {
+		return;
+	}
+
+	if (uart_tx(stream_uart, stream_buf[stream_fill], stream_len, SYS_FOREVER_US) < 0) {
+		atomic_clear(&stream_busy);
+		return;
+	}
+
+	stream_fill ^= 1;
+	stream_len = 0;
+}
+
+static void stream_put_frame(const int32_t *values, uint32_t fresh, uint32_t timestamp)
+{
+	uint8_t frame[STREAM_MAX_FRAME];
+	size_t len = 0;
+
+	frame[len++] = HX711_STREAM_VERSION;
+	frame[len++] = stream_channels;
+	sys_put_le16(stream_seq++, &frame[len]);
+	len += 2;
+	sys_put_le32(timestamp, &frame[len]);
+	len += 4;
+
+	for (uint8_t i = 0; i < DIV_ROUND_UP(stream_channels, 8); i++) {
+		frame[len++] = (uint8_t)(fresh >> (8 * i));
+	}
+
+	for (uint8_t i = 0; i < stream_channels; i++) {
+		sys_put_le24((uint32_t)values[i], &frame[len]);
+		len += 3;
+	}
+
+	sys_put_le16(crc16_ccitt(0xFFFF, frame, len), &frame[len]);
+	len += 2;
+
+	/* Both buffers full means the link is too slow, drop the frame */
+	if (stream_len + STREAM_MAX_ENCODED > sizeof(stream_buf[0])) {
+		stream_kick();
+		if (stream_len + STREAM_MAX_ENCODED > sizeof(stream_buf[0])) {
+			stream_dropped++;
+			return;
+		}
+	}
+
+	stream_len += cobs_encode(frame, len, &stream_buf[stream_fill][stream_len]);
+	stream_buf[stream_fill][stream_len++] = 0x00;
+}
+
+static void stream_aligned(const struct hx711_align_frame *frame, void *user_data)
+{
+	uint32_t fresh = ~frame->stale;
+
+	ARG_UNUSED(user_data);
+
+	if (stream_channels < 32) {
+		fresh &= BIT_MASK(stream_channels);
+	}
+	stream_put_frame(frame->values, fresh, frame->timestamp);
+}
+
+static void stream_thread(void *p1, void *p2, void *p3)
+{
+	struct hx711_sample batch[STREAM_BATCH_SIZE];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		size_t count = hx711_ring_get(&stream_ring, batch, ARRAY_SIZE(batch), K_FOREVER);
+
+		/* Frames are packed as the samples complete grid points */
+		for (size_t i = 0; i < count; i++) {
+			hx711_align_put(&stream_align, &batch[i]);
+		}
+
+		stream_kick();
+	}
+}
+
+K_THREAD_DEFINE(hx711_stream_tid, CONFIG_HX711_STREAM_STACK_SIZE, stream_thread,
+		NULL, NULL, NULL, CONFIG_HX711_STREAM_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+int hx711_stream_init(uint8_t num_channels)
+{
+	int ret;
+
+	ret = hx711_align_init(&stream_align, num_channels, stream_aligned, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!device_is_ready(stream_uart)) {
+		printk("Stream UART %s not ready\n", stream_uart->name);
+		return -ENODEV;
+	}
+
+	ret = uart_callback_set(stream_uart, stream_uart_cb, NULL);
+	if (ret < 0) {
+		printk("Stream UART has no async API: %d\n", ret);
+		return ret;
+	}
+
+	ret = hx711_acq_add_consumer(&stream_ring);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream_channels = num_channels;
+	k_thread_start(hx711_stream_tid);
+
+	return 0;
+}
+
+uint32_t hx711_stream_dropped(void)
+{
+	return stream_dropped + hx711_ring_overruns(&stream_ring);
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HX711_STREAM_H_
+#define HX711_STREAM_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary stream frame, little endian, before COBS encoding:
+ *
+ *   u8  version (HX711_STREAM_VERSION)
+ *   u8  channel count N
+ *   u16 sequence number
+ *   u32 timestamp, cycle count of the alignment grid point
+ *   u8  fresh mask[ceil(N / 8)], bit n set when channel n was interpolated,
+ *       clear when it holds a stale value
+ *   N x 24-bit two's complement samples
+ *   u16 CRC-16/CCITT (seed 0xFFFF) over all of the above
+ *
+ * The COBS encoded frame is terminated by a single 0x00 byte.
+ */
+#define HX711_STREAM_VERSION 2
+
+/* Register the stream consumer, call before hx711_acq_start() */
+int hx711_stream_init(uint8_t num_channels);
+
+uint32_t hx711_stream_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_STREAM_H_ */
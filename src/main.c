@@ -8,83 +8,181 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/sys/printk.h>
 #include "hx711_driver.h"
-#include "hx711_config.h"
+#include "hx711_acq.h"
+#include "hx711_align.h"
+#include "hx711_stream.h"
+#include "hx711_record.h"
 #include <stdint.h>
+#include <stdlib.h>
 #include <zephyr/devicetree.h>
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+#include <zephyr/settings/settings.h>
+#endif
+#ifdef CONFIG_HX711_BUS
+#include "hx711_bus.h"
+#endif
+#ifdef CONFIG_HX711_CAPTURE
+#include "hx711_capture.h"
+#endif
 
-/* HX711 sensor instances */
-static struct hx711_data hx711_0_data;
-static struct hx711_data hx711_1_data;
-static struct hx711_data hx711_2_data;
+/* Every enabled HX711 in devicetree, indexed by sensor id */
+static const struct device *const hx711_devs[] = { HX711_DT_DEVICES };
+
+BUILD_ASSERT(ARRAY_SIZE(hx711_devs) > 0, "No enabled avia,hx711 nodes in devicetree");
+BUILD_ASSERT(ARRAY_SIZE(hx711_devs) <= CONFIG_HX711_ACQ_MAX_SENSORS,
+	     "Raise CONFIG_HX711_ACQ_MAX_SENSORS");
+
+/* Logging consumer, drained in batches by main() */
+#define LOG_BATCH_SIZE 16
+HX711_RING_DEFINE(log_ring);
+
+/* Logged channels are resampled onto one grid, printed one frame per line */
+static struct hx711_align log_align;
+static size_t num_channels;
+static uint32_t frame_count;
+
+/* Conversions averaged for the zero capture at boot */
+#define TARE_SAMPLES 16
+
+/* Print sample-loss, latency and overrun counters every 10 s at the
+ * default 20 Hz alignment grid, which matches the prj.conf decimation
+ */
+#define STATS_INTERVAL_FRAMES 200
+
+#if defined(CONFIG_HX711_STATS) && !defined(CONFIG_HX711_SHELL)
+static void print_sensor_stats(const struct device *dev)
+{
+	struct hx711_stats stats;
+
+	(void)hx711_get_stats(dev, &stats);
+	printk("%s: conversions %u missed %u timeouts %u saturated %u stretched %u "
+	       "quarantines %u latency max %u us\n", dev->name, stats.conversions, stats.missed,
+	       stats.timeouts, stats.saturated, stats.stretched, stats.quarantines,
+	       k_cyc_to_us_floor32(stats.latency_max_cycles));
+}
+#endif
+
+/* SPI sensors have no SCK GPIO to toggle */
+static bool sensor_has_sck(const struct device *dev)
+{
+	const struct hx711_config *cfg = dev->config;
+
+#ifdef CONFIG_HX711_SPI
+	if (cfg->use_spi) {
+		return false;
+	}
+#endif
+	return cfg->sck.port != NULL;
+}
+
+/* Print milli-units as units with three decimals */
+static void print_load(int32_t milli)
+{
+	printk(" %s%d.%03d", milli < 0 ? "-" : "", abs(milli / 1000), abs(milli % 1000));
+}
+
+/* Restore stored calibrations. The sensors that have none keep their
+ * devicetree offset, or are tared with CONFIG_HX711_BOOT_TARE.
+ */
+static void calibrate_sensors(void)
+{
+#ifdef CONFIG_HX711_CALIB_SETTINGS
+	int ret = settings_subsys_init();
+
+	if (ret == 0) {
+		ret = settings_load_subtree("hx711");
+	}
+	if (ret < 0) {
+		printk("Failed to load calibration: %d\n", ret);
+	}
+#endif
+
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		struct hx711_data *hx711 = hx711_devs[i]->data;
+
+		if (hx711->calib_restored) {
+			printk("%s: calibration restored, offset %d\n", hx711_devs[i]->name,
+			       hx711->calib.offset);
+			continue;
+		}
+
+		if (!IS_ENABLED(CONFIG_HX711_BOOT_TARE)) {
+			printk("%s: devicetree offset %d\n", hx711_devs[i]->name,
+			       hx711->calib.offset);
+			continue;
+		}
+
+		if (hx711_tare(hx711_devs[i], TARE_SAMPLES) < 0) {
+			printk("%s: tare failed\n", hx711_devs[i]->name);
+			continue;
+		}
+		printk("%s: tared, offset %d\n", hx711_devs[i]->name, hx711->calib.offset);
+	}
+}
 
 /* Hardware test function */
 void test_hardware_connections(void)
 {
+	bool all_high = true;
+
 	printk("\n=== HARDWARE CONNECTION TEST ===\n");
-	
-	/* Test GPIO devices */
-	const struct device *gpio0 = DEVICE_DT_GET(DT_NODELABEL(gpio0));
-	const struct device *gpio1 = DEVICE_DT_GET(DT_NODELABEL(gpio1));
-	
-	if (!device_is_ready(gpio0)) {
-		printk("ERROR: GPIO0 device not ready!\n");
-		return;
-	}
-	printk("GPIO0 device is ready\n");
-	
-	if (!device_is_ready(gpio1)) {
-		printk("ERROR: GPIO1 device not ready!\n");
-		return;
+
+	/* The driver configured the pins, a sensor that failed init is not ready */
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		if (!device_is_ready(hx711_devs[i])) {
+			printk("ERROR: %s not ready!\n", hx711_devs[i]->name);
+			return;
+		}
 	}
-	printk("GPIO1 device is ready\n");
-	
+	printk("%u HX711 devices are ready\n", (unsigned int)ARRAY_SIZE(hx711_devs));
+
 	/* Test SCK pins as outputs */
 	printk("Testing SCK pins as outputs...\n");
-	
-	/* Configure and test SCK pins */
-	gpio_pin_configure(gpio1, HX711_0_SCK_PIN, GPIO_OUTPUT | GPIO_OUTPUT_LOW);
-	gpio_pin_configure(gpio1, HX711_1_SCK_PIN, GPIO_OUTPUT | GPIO_OUTPUT_LOW);
-	gpio_pin_configure(gpio1, HX711_2_SCK_PIN, GPIO_OUTPUT | GPIO_OUTPUT_LOW);
-	
-	/* Test SCK pins high */
-	gpio_pin_set(gpio1, HX711_0_SCK_PIN, 1);
-	gpio_pin_set(gpio1, HX711_1_SCK_PIN, 1);
-	gpio_pin_set(gpio1, HX711_2_SCK_PIN, 1);
+
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		const struct hx711_config *cfg = hx711_devs[i]->config;
+
+		if (sensor_has_sck(hx711_devs[i])) {
+			gpio_pin_set_dt(&cfg->sck, 1);
+		}
+	}
 	k_msleep(100);
-	
-	/* Test SCK pins low */
-	gpio_pin_set(gpio1, HX711_0_SCK_PIN, 0);
-	gpio_pin_set(gpio1, HX711_1_SCK_PIN, 0);
-	gpio_pin_set(gpio1, HX711_2_SCK_PIN, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		const struct hx711_config *cfg = hx711_devs[i]->config;
+
+		if (sensor_has_sck(hx711_devs[i])) {
+			gpio_pin_set_dt(&cfg->sck, 0);
+		}
+	}
 	k_msleep(100);
-	
+
 	printk("SCK pins configured successfully\n");
-	
-	/* Test DOUT pins as inputs */
-	printk("Testing DOUT pins as inputs...\n");
-	
-	gpio_pin_configure(gpio0, HX711_0_DOUT_PIN, GPIO_INPUT | GPIO_PULL_UP);
-	gpio_pin_configure(gpio0, HX711_1_DOUT_PIN, GPIO_INPUT | GPIO_PULL_UP);
-	gpio_pin_configure(gpio0, HX711_2_DOUT_PIN, GPIO_INPUT | GPIO_PULL_UP);
-	
+
 	/* Read DOUT pin states */
-	int dout0 = gpio_pin_get(gpio0, HX711_0_DOUT_PIN);
-	int dout1 = gpio_pin_get(gpio0, HX711_1_DOUT_PIN);
-	int dout2 = gpio_pin_get(gpio0, HX711_2_DOUT_PIN);
-	
-	printk("DOUT pin states: %d %d %d\n", dout0, dout1, dout2);
-	
-	if (dout0 == 1 && dout1 == 1 && dout2 == 1) {
+	printk("DOUT pin states:");
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		const struct hx711_config *cfg = hx711_devs[i]->config;
+		int dout = gpio_pin_get_dt(&cfg->dout);
+
+		printk(" %d", dout);
+		if (dout != 1) {
+			all_high = false;
+		}
+	}
+	printk("\n");
+
+	if (all_high) {
 		printk("WARNING: All DOUT pins are HIGH - sensors may not be connected!\n");
 		printk("Check your wiring:\n");
 		printk("- VCC to 3.3V or 5V\n");
 		printk("- GND to GND\n");
-		printk("- DOUT to GPIO0 pins (with pull-up)\n");
-		printk("- SCK to GPIO1 pins\n");
+		printk("- DOUT to the dout-gpios pin (with pull-up)\n");
+		printk("- SCK to the sck-gpios pin\n");
 	} else {
 		printk("Some sensors appear to be connected\n");
 	}
-	
+
 	printk("=== END HARDWARE TEST ===\n\n");
 }
 
@@ -92,60 +190,33 @@ void test_hardware_connections(void)
 void test_individual_sensors(void)
 {
 	printk("\n=== INDIVIDUAL SENSOR TEST ===\n");
-	
-	const struct device *gpio0 = DEVICE_DT_GET(DT_NODELABEL(gpio0));
-	const struct device *gpio1 = DEVICE_DT_GET(DT_NODELABEL(gpio1));
-	
+
 	/* Test each sensor individually */
-	for (int sensor = 0; sensor < 3; sensor++) {
-		int sck_pin, dout_pin;
-		const char *sensor_name;
-		const struct device *sck_dev;
-		
-		switch(sensor) {
-			case 0:
-				sck_pin = HX711_0_SCK_PIN;
-				dout_pin = HX711_0_DOUT_PIN;
-				sensor_name = "Sensor 0";
-				sck_dev = gpio1;
-				break;
-			case 1:
-				sck_pin = HX711_1_SCK_PIN;
-				dout_pin = HX711_1_DOUT_PIN;
-				sensor_name = "Sensor 1";
-				sck_dev = gpio1;
-				break;
-			case 2:
-				sck_pin = HX711_2_SCK_PIN;
-				dout_pin = HX711_2_DOUT_PIN;
-				sensor_name = "Sensor 2";
-				sck_dev = gpio1;
-				break;
-		}
-		
-		printk("\n--- Testing %s (SCK: GPIO1.%d, DOUT: GPIO0.%d) ---\n", 
-		       sensor_name, sck_pin, dout_pin);
-		
-		/* Configure pins */
-		gpio_pin_configure(sck_dev, sck_pin, GPIO_OUTPUT | GPIO_OUTPUT_LOW);
-		gpio_pin_configure(gpio0, dout_pin, GPIO_INPUT | GPIO_PULL_UP);
-		
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		const struct device *dev = hx711_devs[i];
+		const struct hx711_config *cfg = dev->config;
+
+		printk("\n--- Testing %s (DOUT: %s.%d) ---\n", dev->name,
+		       cfg->dout.port->name, cfg->dout.pin);
+
 		/* Read initial DOUT state */
-		int initial_dout = gpio_pin_get(gpio0, dout_pin);
+		int initial_dout = gpio_pin_get_dt(&cfg->dout);
 		printk("Initial DOUT state: %d\n", initial_dout);
-		
+
 		/* Test SCK control */
-		gpio_pin_set(sck_dev, sck_pin, 1);
-		k_msleep(50);
-		gpio_pin_set(sck_dev, sck_pin, 0);
-		k_msleep(50);
-		
+		if (sensor_has_sck(dev)) {
+			gpio_pin_set_dt(&cfg->sck, 1);
+			k_msleep(50);
+			gpio_pin_set_dt(&cfg->sck, 0);
+			k_msleep(50);
+		}
+
 		/* Read DOUT after SCK pulse */
-		int after_dout = gpio_pin_get(gpio0, dout_pin);
+		int after_dout = gpio_pin_get_dt(&cfg->dout);
 		printk("DOUT after SCK pulse: %d\n", after_dout);
-		
+
 		if (initial_dout == 1 && after_dout == 1) {
-			printk("RESULT: %s appears to be disconnected or not powered\n", sensor_name);
+			printk("RESULT: %s appears to be disconnected or not powered\n", dev->name);
 			printk("TROUBLESHOOTING:\n");
 			printk("1. Check VCC connection (3.3V or 5V)\n");
 			printk("2. Check GND connection\n");
@@ -153,18 +224,75 @@ void test_individual_sensors(void)
 			printk("4. Check DOUT and SCK wire connections\n");
 			printk("5. Try a different load cell\n");
 		} else if (initial_dout == 0 || after_dout == 0) {
-			printk("RESULT: %s appears to be connected and responding\n", sensor_name);
+			printk("RESULT: %s appears to be connected and responding\n", dev->name);
 		}
 	}
-	
+
+	/* The long SCK pulses powered the sensors down, restart their settle window.
+	 * Reads discard conversions until it has passed, nothing waits here.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+		if (sensor_has_sck(hx711_devs[i])) {
+			hx711_wake_up(hx711_devs[i]);
+		}
+	}
+
 	printk("\n=== END INDIVIDUAL SENSOR TEST ===\n\n");
 }
 
+static void print_frame(const struct hx711_align_frame *frame, void *user_data)
+{
+#ifdef CONFIG_HX711_BUS
+	struct hx711_bus_info bus;
+#endif
+
+	ARG_UNUSED(user_data);
+
+	/* Print calibrated loads, the binary stream carries raw counts otherwise */
+	if (!IS_ENABLED(CONFIG_HX711_STREAM)) {
+		printk("[%u]", frame_count);
+		for (size_t i = 0; i < num_channels; i++) {
+			/* The calibration is for channel A, channel B prints raw counts */
+			if (i >= ARRAY_SIZE(hx711_devs)) {
+				printk(" %d", frame->values[i]);
+			} else {
+				print_load(hx711_acq_load(i, frame->values[i]));
+			}
+
+			/* Held rather than interpolated, the sensor fell behind */
+			if (frame->stale & BIT(i)) {
+				printk("?");
+			}
+		}
+		printk("\n");
+	}
+	frame_count++;
+
+	if ((frame_count % STATS_INTERVAL_FRAMES) == 0) {
+		/* "hx711 snapshot" prints them on demand when there is a shell */
+#if defined(CONFIG_HX711_STATS) && !defined(CONFIG_HX711_SHELL)
+		for (size_t i = 0; i < ARRAY_SIZE(hx711_devs); i++) {
+			print_sensor_stats(hx711_devs[i]);
+		}
+#endif
+		printk("Logging ring overruns: %u\n", hx711_ring_overruns(&log_ring));
+		if (hx711_acq_quarantined() != 0) {
+			printk("Quarantined sensors: 0x%x\n", hx711_acq_quarantined());
+		}
+#ifdef CONFIG_HX711_STREAM
+		printk("Stream frames dropped: %u\n", hx711_stream_dropped());
+#endif
+#ifdef CONFIG_HX711_BUS
+		hx711_bus_get_info(&bus);
+		printk("Bus samples dropped: %u, undelivered: %u\n", bus.dropped, bus.undelivered);
+#endif
+	}
+}
+
 int main(void)
 {
 	int ret;
-	int32_t value_0 = 0, value_1 = 0, value_2 = 0;  /* Initialize to 0 */
-	uint32_t sample_count = 0;
+	struct hx711_sample batch[LOG_BATCH_SIZE];
 
 	printk("HX711 Multi-Sensor Application Starting...\n");
 
@@ -174,96 +302,96 @@ int main(void)
 	/* Run individual sensor test */
 	test_individual_sensors();
 
-	/* Initialize HX711 sensors using device tree GPIO definitions */
-	ret = hx711_init(&hx711_0_data, 
-	                 HX711_0_DOUT_DEV, HX711_0_DOUT_PIN, HX711_0_DOUT_FLAGS,
-	                 HX711_0_SCK_DEV, HX711_0_SCK_PIN, HX711_0_SCK_FLAGS);
+	/* Before acquisition starts, tare reads the sensors directly */
+	calibrate_sensors();
+
+	/* Sensors sharing SCK and DOUT ports are read in lockstep */
+	ret = hx711_acq_init(hx711_devs, ARRAY_SIZE(hx711_devs));
+	if (ret < 0) {
+		printk("Failed to group sensors for acquisition: %d\n", ret);
+		return -1;
+	}
+
+	/* Gain, channel and rate come from devicetree, scanning adds channel B */
+	num_channels = hx711_acq_num_channels();
+
+	ret = hx711_align_init(&log_align, num_channels, print_frame, NULL);
+	if (ret < 0) {
+		printk("Failed to set up channel alignment: %d\n", ret);
+		return -1;
+	}
+
+	ret = hx711_acq_add_consumer(&log_ring);
 	if (ret < 0) {
-		printk("Failed to initialize HX711 sensor 0: %d\n", ret);
+		printk("Failed to register logging consumer: %d\n", ret);
 		return -1;
 	}
 
-	ret = hx711_init(&hx711_1_data, 
-	                 HX711_1_DOUT_DEV, HX711_1_DOUT_PIN, HX711_1_DOUT_FLAGS,
-	                 HX711_1_SCK_DEV, HX711_1_SCK_PIN, HX711_1_SCK_FLAGS);
+#ifdef CONFIG_HX711_STREAM
+	ret = hx711_stream_init(num_channels);
 	if (ret < 0) {
-		printk("Failed to initialize HX711 sensor 1: %d\n", ret);
+		printk("Failed to start binary stream: %d\n", ret);
 		return -1;
 	}
+#endif
 
-	ret = hx711_init(&hx711_2_data, 
-	                 HX711_2_DOUT_DEV, HX711_2_DOUT_PIN, HX711_2_DOUT_FLAGS,
-	                 HX711_2_SCK_DEV, HX711_2_SCK_PIN, HX711_2_SCK_FLAGS);
+#ifdef CONFIG_HX711_BUS
+	ret = hx711_bus_init(num_channels);
 	if (ret < 0) {
-		printk("Failed to initialize HX711 sensor 2: %d\n", ret);
+		printk("Failed to start the sample bus: %d\n", ret);
 		return -1;
 	}
+#endif
 
-	/* Set all sensors to 80 SPS */
-	hx711_set_rate(&hx711_0_data, 80);
-	hx711_set_rate(&hx711_1_data, 80);
-	hx711_set_rate(&hx711_2_data, 80);
+#ifdef CONFIG_HX711_CAPTURE
+	/* Triggers start off, "hx711 capture arm" or the application sets them */
+	ret = hx711_capture_init(num_channels);
+	if (ret < 0) {
+		printk("Failed to start event capture: %d\n", ret);
+		return -1;
+	}
+#endif
+
+#ifdef CONFIG_HX711_RECORD
+	/* Without a log the sensors are still printed and streamed */
+	ret = hx711_record_init(num_channels);
+	if (ret < 0) {
+		printk("Failed to start recording: %d\n", ret);
+	}
+#endif
 
 	printk("All HX711 sensors initialized successfully\n");
 	printk("Starting continuous reading...\n");
-	printk("Format: [Sample] Sensor0 Sensor1 Sensor2\n");
+	printk("Format: [Frame]");
+	for (size_t i = 0; i < num_channels; i++) {
+		printk(" %s%s", hx711_devs[i % ARRAY_SIZE(hx711_devs)]->name,
+		       i < ARRAY_SIZE(hx711_devs) ? "" : "/B");
+	}
+	printk("\n");
 
-	/* Main loop - continuous reading */
+	/* Acquisition runs on its own thread, console output cannot stall it */
+	ret = hx711_acq_start();
+	if (ret < 0) {
+		printk("Failed to start acquisition: %d\n", ret);
+		return -1;
+	}
+
+	/* Main loop - drain the logging ring */
 	while (1) {
-		/* Debug: Print DOUT pin state for all sensors */
-		int dout0 = gpio_pin_get(hx711_0_data.dout_dev, hx711_0_data.dout_pin);
-		int dout1 = gpio_pin_get(hx711_1_data.dout_dev, hx711_1_data.dout_pin);
-		int dout2 = gpio_pin_get(hx711_2_data.dout_dev, hx711_2_data.dout_pin);
-		
-		/* Only print when there's a change or every 100 iterations */
-		static int last_dout0 = -1, last_dout1 = -1, last_dout2 = -1;
-		static int print_counter = 0;
-		
-		if (dout0 != last_dout0 || dout1 != last_dout1 || dout2 != last_dout2 || 
-		    (++print_counter % 100) == 0) {
-			printk("DOUT0: %d DOUT1: %d DOUT2: %d\n", dout0, dout1, dout2);
-			last_dout0 = dout0;
-			last_dout1 = dout1;
-			last_dout2 = dout2;
+		size_t count = hx711_ring_get(&log_ring, batch, ARRAY_SIZE(batch), K_FOREVER);
+
+		if (count == 0) {
+			continue;
 		}
 
-		/* Check if any sensor has data ready (DOUT low) */
-		if (dout0 == 0 || dout1 == 0 || dout2 == 0) {
-			printk("*** DATA READY DETECTED! ***\n");
-			
-			/* Read from sensors that have data ready, keep previous values for others */
-			if (dout0 == 0) {
-				ret = hx711_read_raw(&hx711_0_data, &value_0);
-				if (ret < 0) {
-					printk("Error reading sensor 0: %d\n", ret);
-					/* Keep previous value on error */
-				}
+		for (size_t i = 0; i < count; i++) {
+			if (batch[i].status & HX711_SAMPLE_ERROR) {
+				printk("Error reading sensor %u: %d\n", batch[i].sensor_id, batch[i].raw);
+				continue;
 			}
-			/* If dout0 == 1, keep the previous value_0 */
-
-			if (dout1 == 0) {
-				ret = hx711_read_raw(&hx711_1_data, &value_1);
-				if (ret < 0) {
-					printk("Error reading sensor 1: %d\n", ret);
-					/* Keep previous value on error */
-				}
-			}
-			/* If dout1 == 1, keep the previous value_1 */
-
-			if (dout2 == 0) {
-				ret = hx711_read_raw(&hx711_2_data, &value_2);
-				if (ret < 0) {
-					printk("Error reading sensor 2: %d\n", ret);
-					/* Keep previous value on error */
-				}
-			}
-			/* If dout2 == 1, keep the previous value_2 */
 
-			/* Print raw 24-bit values */
-			printk("[%u] %d %d %d\n", sample_count++, value_0, value_1, value_2);
-		} else {
-			/* No data ready, wait a bit */
-			k_msleep(10);
+			/* Prints every grid frame this sample completes */
+			hx711_align_put(&log_align, &batch[i]);
 		}
 	}
-} 
\ No newline at end of file
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2025 HX711 Driver for Zephyr by GP
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The driver against the behavioural model in src/hx711_emul.c, on the
+ * sensors of boards/native_sim.overlay: hx711_0..2 bit-banged on gpio1
+ * with RATE wired, hx711_3 clocked by the emulated SPI controller with
+ * RATE strapped to 80 SPS. All DOUT lines are on gpio0.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+#include "hx711_driver.h"
+#include "hx711_emul.h"
+
+#define GPIO_SENSORS 3
+#define NUM_SENSORS  4
+
+/* Long enough for a 10 SPS sensor to get through its settle window */
+#define READ_TIMEOUT K_SECONDS(2)
+
+static const struct device *const sensors[NUM_SENSORS] = {
+	DEVICE_DT_GET(DT_NODELABEL(hx711_0)),
+	DEVICE_DT_GET(DT_NODELABEL(hx711_1)),
+	DEVICE_DT_GET(DT_NODELABEL(hx711_2)),
+	DEVICE_DT_GET(DT_NODELABEL(hx711_3)),
+};
+
+/* Every code the decoder must get right: zero, both signs, both limits and
+ * alternating bits across the byte boundaries of the SPI frame
+ */
+static const int32_t script[] = {
+	-0x123456, 0, 1, -1, 0x7FFFFF, -0x800000, 0x5A5A5A, -0x5A5A5B, 0x00FF00,
+};
+
+/* Retries settling conversions and, at 10 SPS, the driver's 50 ms wait */
+static int read_valid(const struct device *dev, int32_t *value)
+{
+	k_timepoint_t end = sys_timepoint_calc(READ_TIMEOUT);
+	int ret;
+
+	do {
+		ret = hx711_read_raw(dev, value);
+	} while ((ret == -EAGAIN || ret == -ETIMEDOUT) && !sys_timepoint_expired(end));
+
+	return ret;
+}
+
+static uint32_t us_since(uint32_t start_cycles)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles);
+}
+
+static void *hx711_setup(void)
+{
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		zassert_true(device_is_ready(sensors[i]), "%s not ready", sensors[i]->name);
+	}
+
+	return NULL;
+}
+
+/* Channel A, gain 64 at 80 SPS, a settled conversion read and a fresh ramp */
+static void hx711_before(void *fixture)
+{
+	int32_t value;
+
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		zassert_ok(hx711_set_gain(sensors[i], 64));
+		zassert_ok(hx711_set_rate(sensors[i], 80));
+		zassert_ok(hx711_emul_set_ramp(sensors[i], (int32_t)i * 100000, 16));
+		zassert_ok(read_valid(sensors[i], &value));
+		zassert_ok(read_valid(sensors[i], &value));
+		zassert_ok(hx711_emul_reset_stats(sensors[i]));
+	}
+}
+
+ZTEST(hx711, test_gain_pulses)
+{
+	/* 25 pulses select A/128, 26 B/32 and 27 A/64 */
+	static const uint8_t gains[] = { 128, 32, 64 };
+	struct hx711_emul_stats stats;
+	int32_t value;
+
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		const struct device *dev = sensors[i];
+
+		for (size_t g = 0; g < ARRAY_SIZE(gains); g++) {
+			zassert_ok(hx711_set_gain(dev, gains[g]));
+			zassert_ok(read_valid(dev, &value));
+			zassert_equal(hx711_emul_gain(dev), gains[g], "%s: gain %u, chip at %d",
+				      dev->name, gains[g], hx711_emul_gain(dev));
+
+			/* The conversion after the switch was taken at the new gain */
+			zassert_ok(read_valid(dev, &value));
+			zassert_equal(hx711_last_gain(dev), gains[g]);
+		}
+
+		zassert_equal(hx711_set_gain(dev, 16), -EINVAL);
+
+		/* 1 us pulses never hold SCK high long enough to power down */
+		zassert_ok(hx711_emul_get_stats(dev, &stats));
+		zassert_equal(stats.sleeps, 0, "%s slept while being read", dev->name);
+		zassert_true(stats.reads >= 2 * ARRAY_SIZE(gains));
+	}
+}
+
+static void check_power_cycle(const struct device *dev, uint8_t sps, uint32_t settle_ms)
+{
+	struct hx711_emul_stats stats;
+	uint32_t conversions;
+	uint32_t start;
+	uint32_t elapsed;
+	int32_t value;
+
+	zassert_ok(hx711_set_rate(dev, sps));
+	zassert_ok(read_valid(dev, &value));
+	zassert_ok(hx711_emul_reset_stats(dev));
+
+	/* SCK held high past 60 us */
+	zassert_ok(hx711_sleep(dev));
+	k_msleep(2 * MSEC_PER_SEC / sps);
+	zassert_true(hx711_emul_is_sleeping(dev), "%s still awake", dev->name);
+
+	zassert_ok(hx711_emul_get_stats(dev, &stats));
+	conversions = stats.conversions;
+	k_msleep(3 * MSEC_PER_SEC / sps);
+	zassert_ok(hx711_emul_get_stats(dev, &stats));
+	zassert_equal(stats.conversions, conversions, "%s converted while powered down",
+		      dev->name);
+	zassert_equal(stats.sleeps, 1);
+
+	/* The first conversion comes after the settling time */
+	start = k_cycle_get_32();
+	zassert_ok(hx711_wake_up(dev));
+	zassert_false(hx711_emul_is_sleeping(dev));
+	zassert_false(K_TIMEOUT_EQ(hx711_settle_remaining(dev), K_NO_WAIT));
+	zassert_ok(hx711_wait_for_data(dev, K_MSEC(2 * settle_ms)));
+	elapsed = us_since(start) / USEC_PER_MSEC;
+	zassert_within(elapsed, settle_ms, 2, "%s: first conversion after %u ms, expected %u",
+		       dev->name, elapsed, settle_ms);
+
+	/* The driver discards it, the chip restarted on channel A/128 */
+	if (CONFIG_HX711_SETTLE_DISCARD > 0) {
+		zassert_equal(hx711_read_raw(dev, &value), -EAGAIN);
+	}
+	zassert_ok(read_valid(dev, &value));
+}
+
+ZTEST(hx711, test_power_down_80sps)
+{
+	check_power_cycle(sensors[0], 80, 50);
+}
+
+ZTEST(hx711, test_power_down_10sps)
+{
+	check_power_cycle(sensors[1], 10, 400);
+}
+
+ZTEST(hx711, test_power_down_spi)
+{
+	/* PD_SCK belongs to the SPI controller, which idles it low */
+	zassert_equal(hx711_sleep(sensors[3]), -ENOTSUP);
+	zassert_equal(hx711_wake_up(sensors[3]), -ENOTSUP);
+}
+
+static void check_data_ready(const struct device *dev, uint8_t sps)
+{
+	struct hx711_emul_stats stats;
+	uint32_t period_us = USEC_PER_SEC / sps;
+	uint32_t edge;
+	uint32_t spacing;
+	int32_t value;
+
+	zassert_ok(hx711_set_rate(dev, sps));
+	zassert_ok(read_valid(dev, &value));
+
+	/* Edge to edge, each conversion read as soon as it is ready */
+	zassert_ok(hx711_wait_for_data(dev, K_USEC(2 * period_us)));
+	edge = k_cycle_get_32();
+	zassert_ok(hx711_read_raw(dev, &value));
+	zassert_ok(hx711_wait_for_data(dev, K_USEC(2 * period_us)));
+	spacing = us_since(edge);
+	zassert_within(spacing, period_us, 2 * USEC_PER_MSEC, "%s at %u SPS: %u us apart",
+		       dev->name, sps, spacing);
+
+	/* Conversions keep coming unread, one per period */
+	zassert_ok(hx711_emul_reset_stats(dev));
+	k_msleep(MSEC_PER_SEC);
+	zassert_ok(hx711_emul_get_stats(dev, &stats));
+	zassert_within(stats.conversions, sps, 1, "%s: %u conversions in 1 s at %u SPS",
+		       dev->name, stats.conversions, sps);
+	zassert_true(stats.overwritten + 1 >= stats.conversions);
+}
+
+ZTEST(hx711, test_data_ready_80sps)
+{
+	check_data_ready(sensors[0], 80);
+	check_data_ready(sensors[3], 80);
+}
+
+ZTEST(hx711, test_data_ready_10sps)
+{
+	check_data_ready(sensors[2], 10);
+
+	/* Strapped at 80 SPS */
+	zassert_equal(hx711_set_rate(sensors[3], 10), -ENOTSUP);
+}
+
+ZTEST(hx711, test_script_round_trip)
+{
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		const struct device *dev = sensors[i];
+		int32_t value;
+		size_t n;
+
+		zassert_ok(hx711_emul_set_script(dev, script, ARRAY_SIZE(script), false));
+
+		/* A conversion made before the script may still be waiting */
+		for (size_t tries = 0; tries < 3; tries++) {
+			zassert_ok(read_valid(dev, &value));
+			if (value == script[0]) {
+				break;
+			}
+		}
+		zassert_equal(value, script[0], "%s: script did not start", dev->name);
+
+		for (n = 1; n < ARRAY_SIZE(script); n++) {
+			zassert_ok(read_valid(dev, &value));
+			zassert_equal(value, script[n], "%s: conversion %zu is %d, expected %d",
+				      dev->name, n, value, script[n]);
+		}
+
+		/* Without loop the last sample holds */
+		zassert_ok(read_valid(dev, &value));
+		zassert_equal(value, script[ARRAY_SIZE(script) - 1]);
+	}
+}
+
+ZTEST(hx711, test_array_lockstep)
+{
+	static const int32_t expected[NUM_SENSORS] = { -700000, 12345, 0x7FFFFF, -0x800000 };
+	struct hx711_emul_stats before[NUM_SENSORS];
+	struct hx711_emul_stats after;
+	struct hx711_array array;
+	int32_t values[NUM_SENSORS];
+	uint32_t mask;
+	uint32_t read = 0;
+	bool together = false;
+
+	zassert_ok(hx711_array_init(&array, sensors, NUM_SENSORS));
+
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		zassert_ok(hx711_emul_set_script(sensors[i], &expected[i], 1, true));
+		zassert_ok(hx711_emul_get_stats(sensors[i], &before[i]));
+	}
+
+	for (int pass = 0; pass < 8 && !together; pass++) {
+		/* Unread conversions keep DOUT low, so after two periods every
+		 * member is ready and one frame clocks out all of them
+		 */
+		k_msleep(25);
+		zassert_equal(hx711_array_ready_mask(&array), BIT_MASK(NUM_SENSORS));
+
+		mask = BIT_MASK(NUM_SENSORS);
+		zassert_ok(hx711_array_read_raw(&array, &mask, values));
+
+		for (size_t i = 0; i < NUM_SENSORS; i++) {
+			if ((mask & BIT(i)) && values[i] != expected[i]) {
+				/* Converted before the script was set */
+				mask &= ~BIT(i);
+			}
+		}
+		read |= mask;
+		together = mask == BIT_MASK(NUM_SENSORS);
+	}
+
+	zassert_equal(read, BIT_MASK(NUM_SENSORS), "members read 0x%x", read);
+	zassert_true(together, "no pass read every member");
+
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		zassert_ok(hx711_emul_get_stats(sensors[i], &after));
+		zassert_true(after.reads > before[i].reads, "%s never clocked", sensors[i]->name);
+		zassert_equal(after.sleeps, before[i].sleeps);
+		/* The gain pulses went out with the frame */
+		zassert_equal(hx711_emul_gain(sensors[i]), 64);
+	}
+
+	/* Nothing ready right after a read, nothing clocked */
+	mask = BIT_MASK(GPIO_SENSORS);
+	zassert_ok(hx711_array_read_raw(&array, &mask, values));
+	zassert_equal(mask, 0);
+}
+
+ZTEST_SUITE(hx711, NULL, hx711_setup, hx711_before, NULL, NULL);
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 HX711 Driver for Zephyr by GP
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode HX711 log blocks exported with "hx711 log export" (see src/hx711_block.h).
+
+Reads a console capture, picks out the lines that are one hex encoded block
+each and prints one CSV line per frame:
+
+    boot,seq,time_ms,stale_mask,ch0,ch1,...
+
+time_ms is the uptime of the frame's grid point in its boot. A set bit in
+stale_mask marks a channel that held its previous value instead of being
+interpolated.
+
+Examples:
+    hx711_log_decode.py capture.txt
+    hx711_log_decode.py - < capture.txt
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+BLOCK_VERSION = 1
+HEADER = struct.Struct("<BBHHHIIQ")
+HEX_LINE = re.compile(r"^(?:[0-9a-fA-F]{2})+$")
+
+
+def zigzag_decode(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+class Block:
+    def __init__(self, data):
+        if len(data) < HEADER.size:
+            raise ValueError("short block")
+        (self.version, self.channels, self.frames, self.boot, length, self.seq,
+         self.period_us, self.time_ms) = HEADER.unpack_from(data, 0)
+        if self.version != BLOCK_VERSION:
+            raise ValueError("unknown version %d" % self.version)
+        if self.channels == 0 or length < HEADER.size or length > len(data):
+            raise ValueError("bad header")
+        self.data = data[:length]
+        self.pos = HEADER.size
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data) or shift > 28:
+                raise ValueError("truncated varint")
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def nibbles(self):
+        count = (self.channels + 1) // 2
+        if self.pos + count > len(self.data):
+            raise ValueError("truncated frame")
+        packed = self.data[self.pos:self.pos + count]
+        self.pos += count
+        return [(packed[i // 2] >> (4 * (i & 1))) & 0x0F for i in range(self.channels)]
+
+    def __iter__(self):
+        values = [0] * self.channels
+        periods = 0
+        for _ in range(self.frames):
+            tag = self.varint()
+            stale = self.varint() if tag & 1 else 0
+            if tag & 2:
+                deltas = self.nibbles()
+            else:
+                deltas = [self.varint() for _ in range(self.channels)]
+            values = [v + zigzag_decode(d) for v, d in zip(values, deltas)]
+            # Wrap like the firmware's int32_t arithmetic
+            values = [(v + (1 << 31)) % (1 << 32) - (1 << 31) for v in values]
+            periods += tag >> 2
+            yield self.time_ms * 1000 + periods * self.period_us, stale, values
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file", help="console capture, '-' for stdin")
+    args = parser.parse_args()
+
+    stream = sys.stdin if args.file == "-" else open(args.file)
+
+    errors = 0
+    last_seq = None
+    lost = 0
+    for line in stream:
+        line = line.strip()
+        if len(line) < 2 * HEADER.size or not HEX_LINE.match(line):
+            continue
+        try:
+            block = Block(bytes.fromhex(line))
+            rows = list(block)
+        except ValueError as err:
+            errors += 1
+            print("# dropped block: %s" % err, file=sys.stderr)
+            continue
+        if last_seq is not None:
+            lost += max(block.seq - last_seq - 1, 0)
+        last_seq = block.seq
+        for time_us, stale, values in rows:
+            print(",".join(str(v) for v in
+                           [block.boot, block.seq, "%.3f" % (time_us / 1000), stale] + values))
+
+    print("# %d bad blocks, %d blocks lost" % (errors, lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
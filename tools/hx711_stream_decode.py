@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 HX711 Driver for Zephyr by GP
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode the HX711 binary sample stream (see src/hx711_stream.h).
+
+Reads COBS framed records from a serial port or a capture file and prints
+one CSV line per valid frame:
+
+    seq,timestamp,fresh_mask,ch0,ch1,...
+
+Every frame is one point of the firmware's alignment grid. A clear bit in
+fresh_mask marks a channel that held a stale value instead of being
+interpolated.
+
+Examples:
+    hx711_stream_decode.py --port /dev/ttyACM0 --baud 115200
+    hx711_stream_decode.py --file capture.bin
+"""
+
+import argparse
+import struct
+import sys
+
+STREAM_VERSION = 2
+
+
+def crc16_ccitt(data, seed=0xFFFF):
+    """Zephyr crc16_ccitt(): reflected polynomial 0x8408, no final XOR."""
+    crc = seed
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("bad COBS block")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(frame):
+    if len(frame) < 10:
+        raise ValueError("short frame")
+    body, crc = frame[:-2], struct.unpack_from("<H", frame, len(frame) - 2)[0]
+    if crc16_ccitt(body) != crc:
+        raise ValueError("CRC mismatch")
+    version, channels, seq, timestamp = struct.unpack_from("<BBHI", body, 0)
+    if version != STREAM_VERSION:
+        raise ValueError("unknown version %d" % version)
+    pos = 8
+    mask_len = (channels + 7) // 8
+    fresh = int.from_bytes(body[pos:pos + mask_len], "little")
+    pos += mask_len
+    if len(body) != pos + 3 * channels:
+        raise ValueError("length mismatch")
+    values = []
+    for ch in range(channels):
+        raw = int.from_bytes(body[pos:pos + 3], "little")
+        values.append(raw - (1 << 24) if raw & 0x800000 else raw)
+        pos += 3
+    return seq, timestamp, fresh, values
+
+
+def frames(read):
+    """Yield COBS frames from read(), which returns b"" only at the end."""
+    pending = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            return
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            encoded, pending = bytes(pending[:end]), pending[end + 1:]
+            if encoded:
+                yield encoded
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port")
+    source.add_argument("--file", help="raw capture file, '-' for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+
+        # No timeout: a port has no end, idle and settle gaps just block
+        stream = serial.Serial(args.port, args.baud, timeout=None)
+
+        def read():
+            return stream.read(max(1, stream.in_waiting))
+    else:
+        if args.file == "-":
+            stream = sys.stdin.buffer
+        else:
+            stream = open(args.file, "rb")
+
+        def read():
+            return stream.read(256)
+
+    errors = 0
+    last_seq = None
+    lost = 0
+    for encoded in frames(read):
+        try:
+            seq, timestamp, fresh, values = parse_frame(cobs_decode(encoded))
+        except ValueError as err:
+            errors += 1
+            print("# dropped frame: %s" % err, file=sys.stderr)
+            continue
+        if last_seq is not None:
+            lost += (seq - last_seq - 1) & 0xFFFF
+        last_seq = seq
+        print(",".join(str(v) for v in [seq, timestamp, fresh] + values))
+
+    print("# %d bad frames, %d frames lost" % (errors, lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()